@@ -0,0 +1,23 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+void* MonotonicArena::Allocate(size_t bytes, size_t alignment) {
+    if (!m_chunks.empty()) {
+        Chunk& chunk = m_chunks.back();
+        uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data.get());
+        size_t offset = ((base + m_used + alignment - 1) & ~(alignment - 1)) - base;
+        if (offset + bytes <= chunk.size) {
+            m_used = offset + bytes;
+            return chunk.data.get() + offset;
+        }
+    }
+
+    // The rest of a full chunk is left unused
+    size_t size = std::max(m_chunkBytes, bytes + alignment);
+    m_chunks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[size]), size });
+    m_used = 0;
+    m_reserved += size;
+    return Allocate(bytes, alignment);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator over a list of chunks, for storage that lives as long as
+// the arena and is recycled by its owner (see SubmitQueue's node pool and
+// NameTable). Nothing is freed before the arena is destroyed. Not thread-safe.
+class MonotonicArena {
+public:
+    explicit MonotonicArena(size_t chunkBytes = 64 * 1024) : m_chunkBytes(chunkBytes) {}
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void* Allocate(size_t bytes, size_t alignment);
+
+    // Uninitialized storage; only for types that never need destroying
+    template <typename T>
+    T* Allocate(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destroyed");
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Bytes held in chunks, used or not
+    size_t BytesReserved() const { return m_reserved; }
+
+private:
+    struct Chunk {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+
+    std::vector<Chunk> m_chunks;
+    size_t m_chunkBytes;
+    size_t m_used = 0;          // Bytes used in the last chunk
+    size_t m_reserved = 0;
+};
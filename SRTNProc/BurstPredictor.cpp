@@ -0,0 +1,104 @@
+#include "BurstPredictor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "Checkpoint.h"
+
+int BurstPredictor::Predict(NameId name) const {
+    if (name < m_classes.size() && m_classes[name] >= 0) {
+        return std::max(1, static_cast<int>(std::lround(m_classes[name])));
+    }
+    return m_observed ? std::max(1, static_cast<int>(std::lround(m_global))) : m_options.initialGuess;
+}
+
+void BurstPredictor::Observe(NameId name, int burstTime) {
+    double alpha = m_options.alpha;
+    if (name >= m_classes.size()) {
+        m_classes.resize(name + 1, -1.0);
+    }
+    if (m_classes[name] < 0) {
+        // The first sample of a class is the best guess for it
+        m_classes[name] = burstTime;
+    }
+    else {
+        m_classes[name] = alpha * burstTime + (1.0 - alpha) * m_classes[name];
+    }
+    m_global = m_observed ? alpha * burstTime + (1.0 - alpha) * m_global : burstTime;
+    m_observed = true;
+}
+
+void BurstPredictor::Clear() {
+    m_classes.clear();
+    m_global = 0;
+    m_observed = false;
+}
+
+void BurstPredictor::Save(ByteWriter& writer) const {
+    writer.Put(m_options.alpha);
+    writer.Put(m_options.initialGuess);
+    writer.Put(m_global);
+    writer.Put<uint8_t>(m_observed ? 1 : 0);
+    uint64_t classes = std::count_if(m_classes.begin(), m_classes.end(), [](double value) { return value >= 0; });
+    writer.Put(classes);
+    for (size_t name = 0; name < m_classes.size(); name++) {
+        if (m_classes[name] >= 0) {
+            writer.PutName(static_cast<NameId>(name));
+            writer.Put(m_classes[name]);
+        }
+    }
+}
+
+bool BurstPredictor::Load(ByteReader& reader) {
+    Clear();
+    uint8_t observed = 0;
+    uint64_t classes = 0;
+    reader.Get(m_options.alpha);
+    reader.Get(m_options.initialGuess);
+    reader.Get(m_global);
+    reader.Get(observed);
+    reader.Get(classes);
+    m_observed = observed != 0;
+    for (uint64_t i = 0; i < classes && reader.Ok(); i++) {
+        NameId name = EMPTY_NAME;
+        double average = 0;
+        reader.GetName(name);
+        reader.Get(average);
+        if (name >= m_classes.size()) {
+            m_classes.resize(name + 1, -1.0);
+        }
+        m_classes[name] = average;
+    }
+    return reader.Ok();
+}
+
+template <typename Time>
+PredictionError MeasurePredictionError(const std::vector<BasicProcess<Time>>& processes, const std::vector<Time>& estimates) {
+    PredictionError error;
+    double absolute = 0;
+    double relative = 0;
+    double bias = 0;
+    for (size_t i = 0; i < processes.size() && i < estimates.size(); i++) {
+        const BasicProcess<Time>& p = processes[i];
+        if (!p.completed || p.burstTime <= 0) {
+            continue;
+        }
+        long long diff = static_cast<long long>(estimates[i]) - p.burstTime;
+        absolute += std::abs(diff);
+        relative += std::abs(diff) / static_cast<double>(p.burstTime);
+        bias += diff;
+        error.samples++;
+    }
+    if (error.samples > 0) {
+        error.meanAbsolute = absolute / error.samples;
+        error.meanRelative = relative / error.samples;
+        error.bias = bias / error.samples;
+    }
+    return error;
+}
+
+template PredictionError MeasurePredictionError(const std::vector<BasicProcess<int32_t>>& processes,
+    const std::vector<int32_t>& estimates);
+template PredictionError MeasurePredictionError(const std::vector<BasicProcess<int64_t>>& processes,
+    const std::vector<int64_t>& estimates);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "Process.h"
+
+class ByteReader;
+class ByteWriter;
+
+struct PredictorOptions {
+    double alpha = 0.5;         // Weight of the latest observed burst
+    int initialGuess = 10;      // Used before anything has completed
+};
+
+// Exponential average of observed bursts per process name:
+//   tau(n+1) = alpha * t(n) + (1 - alpha) * tau(n)
+// Names never seen before fall back to the average over all names.
+class BurstPredictor {
+public:
+    explicit BurstPredictor(const PredictorOptions& options = PredictorOptions()) : m_options(options) {}
+
+    int Predict(NameId name) const;
+    void Observe(NameId name, int burstTime);
+    void Clear();
+
+    // Checkpoint support: options and every class average
+    void Save(ByteWriter& writer) const;
+    bool Load(ByteReader& reader);
+
+    const PredictorOptions& Options() const { return m_options; }
+
+private:
+    PredictorOptions m_options;
+    std::vector<double> m_classes;      // By name id; negative = never observed
+    double m_global = 0;
+    bool m_observed = false;
+};
+
+struct PredictionError {
+    size_t samples = 0;
+    double meanAbsolute = 0;    // Time units
+    double meanRelative = 0;    // |estimate - burst| / burst
+    double bias = 0;            // Mean of estimate - burst; negative = underestimates
+};
+
+// Error of the estimates the engine ordered by, over completed processes
+template <typename Time>
+PredictionError MeasurePredictionError(const std::vector<BasicProcess<Time>>& processes, const std::vector<Time>& estimates);
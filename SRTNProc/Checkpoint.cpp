@@ -0,0 +1,192 @@
+#include "Checkpoint.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+#include <cstdio>
+
+namespace {
+
+const char CHECKPOINT_MAGIC[8] = { 'S', 'R', 'T', 'N', 'C', 'K', 'P', 'T' };
+
+} // namespace
+
+// A name is its local index; an index one past the table introduces a new
+// name and is followed by its length and UTF-32 code units
+void ByteWriter::PutName(NameId name) {
+    if (name >= m_local.size()) {
+        m_local.resize(name + 1, 0);
+    }
+    if (m_local[name] != 0) {
+        Put<uint32_t>(m_local[name] - 1);
+        return;
+    }
+    uint32_t index = m_written++;
+    m_local[name] = index + 1;
+    Put<uint32_t>(index);
+    std::wstring_view text = ProcessNames().View(name);
+    Put<uint32_t>(static_cast<uint32_t>(text.size()));
+    for (wchar_t c : text) {
+        Put<uint32_t>(static_cast<uint32_t>(c));
+    }
+}
+
+bool ByteReader::GetName(NameId& name) {
+    uint32_t index = 0;
+    if (!Get(index) || index > m_names.size()) {
+        m_ok = false;
+        return false;
+    }
+    if (index < m_names.size()) {
+        name = m_names[index];
+        return true;
+    }
+    uint32_t length = 0;
+    if (!Get(length) || length > (m_size - m_at) / sizeof(uint32_t)) {
+        m_ok = false;
+        return false;
+    }
+    std::wstring text(length, L'\0');
+    for (uint32_t i = 0; i < length; i++) {
+        uint32_t c = 0;
+        Get(c);
+        text[i] = static_cast<wchar_t>(c);
+    }
+    name = ProcessNames().Intern(text);
+    m_names.push_back(name);
+    return m_ok;
+}
+
+void WriteCheckpointHeader(ByteWriter& writer, size_t timeBytes, size_t indexBytes) {
+    for (char c : CHECKPOINT_MAGIC) {
+        writer.Put(c);
+    }
+    writer.Put<uint32_t>(CHECKPOINT_VERSION);
+    writer.Put<uint8_t>(static_cast<uint8_t>(timeBytes));
+    writer.Put<uint8_t>(static_cast<uint8_t>(indexBytes));
+}
+
+bool ReadCheckpointHeader(ByteReader& reader, size_t& timeBytes, size_t& indexBytes, std::string& error) {
+    for (char expected : CHECKPOINT_MAGIC) {
+        char c = 0;
+        if (!reader.Get(c) || c != expected) {
+            error = "not a checkpoint";
+            return false;
+        }
+    }
+    uint32_t version = 0;
+    uint8_t timeWidth = 0;
+    uint8_t indexWidth = 0;
+    reader.Get(version);
+    reader.Get(timeWidth);
+    reader.Get(indexWidth);
+    if (!reader.Ok()) {
+        error = "truncated header";
+        return false;
+    }
+    if (version != CHECKPOINT_VERSION) {
+        error = "unsupported version " + std::to_string(version);
+        return false;
+    }
+    timeBytes = timeWidth;
+    indexBytes = indexWidth;
+    return true;
+}
+
+bool WriteFileAtomic(const std::string& path, const std::vector<unsigned char>& bytes) {
+    std::string temp = path + ".tmp";
+    FILE* file = fopen(temp.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        remove(temp.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    return MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(temp.c_str(), path.c_str()) == 0;
+#endif
+}
+
+bool ReadWholeFile(const std::string& path, std::vector<unsigned char>& bytes) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    bytes.clear();
+    unsigned char buffer[65536];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + read);
+    }
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+CheckpointWriter::CheckpointWriter(const std::string& path)
+    : m_path(path), m_thread(&CheckpointWriter::WriterLoop, this) {
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_changed.notify_all();
+    m_thread.join();
+}
+
+void CheckpointWriter::Write(std::vector<unsigned char>& snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.swap(snapshot);
+        m_hasPending = true;
+    }
+    m_changed.notify_all();
+}
+
+void CheckpointWriter::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [this]() { return !m_hasPending && !m_busy; });
+}
+
+long long CheckpointWriter::Written() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_written;
+}
+
+bool CheckpointWriter::Failed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failed;
+}
+
+void CheckpointWriter::WriterLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_changed.wait(lock, [this]() { return m_hasPending || m_stop; });
+        if (!m_hasPending) {
+            return;
+        }
+        m_writing.swap(m_pending);
+        m_hasPending = false;
+        m_busy = true;
+
+        lock.unlock();
+        bool ok = WriteFileAtomic(m_path, m_writing);
+        lock.lock();
+
+        m_busy = false;
+        m_failed = m_failed || !ok;
+        m_written += ok ? 1 : 0;
+        m_changed.notify_all();
+    }
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "NameTable.h"
+
+// Engine checkpoints are little-endian binary snapshots:
+//
+//   "SRTNCKPT" version:u32 timeBytes:u8 indexBytes:u8 ...engine state...
+//
+// Numbers are written at their in-memory width. Names are written once, the
+// first time they are referenced, and by a small local index after that, so
+// a checkpoint does not depend on NameId values from the process that wrote it.
+const uint32_t CHECKPOINT_VERSION = 4;
+
+// Appends to out. The vector is grown in large steps and trimmed to what was
+// written when the writer goes out of scope, so a small Put is a memcpy.
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<unsigned char>& out) : m_out(out), m_size(out.size()) {}
+    ByteWriter(const ByteWriter&) = delete;
+    ByteWriter& operator=(const ByteWriter&) = delete;
+    ~ByteWriter() { m_out.resize(m_size); }
+
+    template <typename T>
+    void Put(T value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "only numbers are written raw");
+        Grow(sizeof(T));
+        std::memcpy(m_out.data() + m_size, &value, sizeof(T));
+        m_size += sizeof(T);
+    }
+
+    template <typename T>
+    void PutArray(const std::vector<T>& values) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "only numbers are written raw");
+        Put<uint64_t>(values.size());
+        Grow(values.size() * sizeof(T));
+        if (!values.empty()) {
+            std::memcpy(m_out.data() + m_size, values.data(), values.size() * sizeof(T));
+        }
+        m_size += values.size() * sizeof(T);
+    }
+
+    void PutName(NameId name);
+
+private:
+    void Grow(size_t bytes) {
+        if (m_out.size() - m_size < bytes) {
+            m_out.resize(std::max(m_out.size() * 2, m_size + bytes + 4096));
+        }
+    }
+
+    std::vector<unsigned char>& m_out;
+    size_t m_size;
+    std::vector<uint32_t> m_local;      // By NameId; 0 = not written yet, else local index + 1
+    uint32_t m_written = 0;
+};
+
+// Every Get fails once any read has failed, so callers check Ok() at the end
+class ByteReader {
+public:
+    ByteReader(const unsigned char* data, size_t size) : m_data(data), m_size(size) {}
+
+    template <typename T>
+    bool Get(T& value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "only numbers are read raw");
+        if (!m_ok || m_size - m_at < sizeof(T)) {
+            m_ok = false;
+            return false;
+        }
+        std::memcpy(&value, m_data + m_at, sizeof(T));
+        m_at += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool GetArray(std::vector<T>& values) {
+        uint64_t count = 0;
+        if (!Get(count) || count > (m_size - m_at) / sizeof(T)) {
+            m_ok = false;
+            return false;
+        }
+        values.resize(static_cast<size_t>(count));
+        if (count > 0) {
+            std::memcpy(values.data(), m_data + m_at, values.size() * sizeof(T));
+        }
+        m_at += values.size() * sizeof(T);
+        return true;
+    }
+
+    // Interns names into ProcessNames() as they are first seen
+    bool GetName(NameId& name);
+
+    bool Ok() const { return m_ok; }
+    bool AtEnd() const { return m_at == m_size; }
+
+private:
+    const unsigned char* m_data;
+    size_t m_size;
+    size_t m_at = 0;
+    bool m_ok = true;
+    std::vector<NameId> m_names;
+};
+
+void WriteCheckpointHeader(ByteWriter& writer, size_t timeBytes, size_t indexBytes);
+
+// Validates the magic and version and returns the engine widths it was written with
+bool ReadCheckpointHeader(ByteReader& reader, size_t& timeBytes, size_t& indexBytes, std::string& error);
+
+// Replaces path through a temporary file, so a crash mid-write leaves the
+// previous checkpoint intact
+bool WriteFileAtomic(const std::string& path, const std::vector<unsigned char>& bytes);
+bool ReadWholeFile(const std::string& path, std::vector<unsigned char>& bytes);
+
+// Writes checkpoints on a background thread, so the scheduler only pays for
+// the in-memory capture. A newer snapshot replaces one still waiting to be
+// written: only the latest state matters.
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(const std::string& path);
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+    // Writes the last snapshot still pending, then stops
+    ~CheckpointWriter();
+
+    // Takes the snapshot by swapping buffers; snapshot comes back holding an
+    // older buffer whose capacity the next capture can reuse
+    void Write(std::vector<unsigned char>& snapshot);
+
+    // Blocks until everything handed over so far is on disk
+    void Flush();
+
+    long long Written() const;
+    bool Failed() const;
+
+private:
+    void WriterLoop();
+
+    std::string m_path;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::vector<unsigned char> m_pending;
+    std::vector<unsigned char> m_writing;
+    bool m_hasPending = false;
+    bool m_busy = false;
+    bool m_stop = false;
+    bool m_failed = false;
+    long long m_written = 0;
+    std::thread m_thread;
+};
@@ -0,0 +1,388 @@
+#include "Dispatcher.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <tlhelp32.h>
+#else
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+// One launched command and everything it spawns
+class ChildJob {
+public:
+    ChildJob() = default;
+    ChildJob(const ChildJob&) = delete;
+    ChildJob& operator=(const ChildJob&) = delete;
+    ~ChildJob();
+
+    bool Launch(const std::string& command);
+    void Suspend();
+    void Resume();
+    // True once the command has exited; CPU time and exit code are final then
+    bool Poll();
+    double CpuMs();
+    int ExitCode() const { return m_exitCode; }
+
+private:
+#ifdef _WIN32
+    void SetSuspended(bool suspend);
+
+    HANDLE m_job = nullptr;
+    HANDLE m_process = nullptr;
+#else
+    pid_t m_pid = -1;
+    double m_finalCpuMs = 0;
+#endif
+    bool m_exited = false;
+    int m_exitCode = -1;
+};
+
+#ifdef _WIN32
+ChildJob::~ChildJob() {
+    if (m_process != nullptr) {
+        CloseHandle(m_process);
+    }
+    if (m_job != nullptr) {
+        CloseHandle(m_job);
+    }
+}
+
+bool ChildJob::Launch(const std::string& command) {
+    std::string line = "cmd.exe /c " + command;
+    std::wstring wide(MultiByteToWideChar(CP_ACP, 0, line.c_str(), -1, nullptr, 0), L'\0');
+    MultiByteToWideChar(CP_ACP, 0, line.c_str(), -1, &wide[0], static_cast<int>(wide.size()));
+
+    // The job object lets us account and suspend everything the command spawns
+    m_job = CreateJobObject(nullptr, nullptr);
+    STARTUPINFOW startup = { sizeof(startup) };
+    PROCESS_INFORMATION info = {};
+    if (m_job == nullptr ||
+        !CreateProcessW(nullptr, &wide[0], nullptr, nullptr, FALSE, CREATE_SUSPENDED | CREATE_NO_WINDOW,
+            nullptr, nullptr, &startup, &info)) {
+        m_exited = true;
+        return false;
+    }
+    AssignProcessToJobObject(m_job, info.hProcess);
+    ResumeThread(info.hThread);
+    CloseHandle(info.hThread);
+    m_process = info.hProcess;
+    return true;
+}
+
+void ChildJob::SetSuspended(bool suspend) {
+    // Room for the command plus a few dozen descendants
+    struct {
+        JOBOBJECT_BASIC_PROCESS_ID_LIST list;
+        ULONG_PTR more[63];
+    } ids = {};
+    if (!QueryInformationJobObject(m_job, JobObjectBasicProcessIdList, &ids, sizeof(ids), nullptr)) {
+        return;
+    }
+
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    THREADENTRY32 entry = { sizeof(entry) };
+    for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+        bool member = false;
+        for (DWORD i = 0; i < ids.list.NumberOfProcessIdsInList; i++) {
+            if (ids.list.ProcessIdList[i] == entry.th32OwnerProcessID) {
+                member = true;
+                break;
+            }
+        }
+        if (!member) {
+            continue;
+        }
+        HANDLE thread = OpenThread(THREAD_SUSPEND_RESUME, FALSE, entry.th32ThreadID);
+        if (thread != nullptr) {
+            if (suspend) {
+                SuspendThread(thread);
+            }
+            else {
+                ResumeThread(thread);
+            }
+            CloseHandle(thread);
+        }
+    }
+    CloseHandle(snapshot);
+}
+
+void ChildJob::Suspend() { SetSuspended(true); }
+void ChildJob::Resume() { SetSuspended(false); }
+
+bool ChildJob::Poll() {
+    if (!m_exited && m_process != nullptr && WaitForSingleObject(m_process, 0) == WAIT_OBJECT_0) {
+        DWORD code = 0;
+        GetExitCodeProcess(m_process, &code);
+        m_exitCode = static_cast<int>(code);
+        m_exited = true;
+    }
+    return m_exited;
+}
+
+double ChildJob::CpuMs() {
+    JOBOBJECT_BASIC_ACCOUNTING_INFORMATION accounting = {};
+    if (m_job == nullptr ||
+        !QueryInformationJobObject(m_job, JobObjectBasicAccountingInformation, &accounting, sizeof(accounting), nullptr)) {
+        return 0;
+    }
+    // 100 ns units
+    return (accounting.TotalUserTime.QuadPart + accounting.TotalKernelTime.QuadPart) / 10000.0;
+}
+#else
+ChildJob::~ChildJob() {
+    if (m_pid > 0 && !m_exited) {
+        kill(-m_pid, SIGKILL);
+        kill(-m_pid, SIGCONT);
+        waitpid(m_pid, nullptr, 0);
+    }
+}
+
+bool ChildJob::Launch(const std::string& command) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        m_exited = true;
+        return false;
+    }
+    if (pid == 0) {
+        // Own process group, so SIGSTOP/SIGCONT reach pipelines and children too
+        setpgid(0, 0);
+        execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    setpgid(pid, pid);
+    m_pid = pid;
+    return true;
+}
+
+void ChildJob::Suspend() {
+    if (m_pid > 0 && !m_exited) {
+        kill(-m_pid, SIGSTOP);
+    }
+}
+
+void ChildJob::Resume() {
+    if (m_pid > 0 && !m_exited) {
+        kill(-m_pid, SIGCONT);
+    }
+}
+
+bool ChildJob::Poll() {
+    if (m_exited || m_pid <= 0) {
+        return true;
+    }
+    int status = 0;
+    rusage usage = {};
+    if (wait4(m_pid, &status, WNOHANG, &usage) != m_pid) {
+        return false;
+    }
+    m_exited = true;
+    m_exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    m_finalCpuMs = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+        (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+    return true;
+}
+
+double ChildJob::CpuMs() {
+    if (m_exited) {
+        return m_finalCpuMs;
+    }
+    if (m_pid <= 0) {
+        return 0;
+    }
+    // utime, stime, cutime and cstime are fields 14-17 of /proc/<pid>/stat,
+    // counted after the parenthesised command name
+    std::ifstream stat("/proc/" + std::to_string(m_pid) + "/stat");
+    std::string text;
+    std::getline(stat, text);
+    size_t cursor = text.rfind(')');
+    if (cursor == std::string::npos) {
+        return 0;
+    }
+    const char* field = text.c_str() + cursor + 2;
+    long long ticks = 0;
+    for (int index = 3; index <= 17 && *field != '\0'; index++) {
+        char* end = nullptr;
+        long long value = strtoll(field, &end, 10);
+        if (index >= 14) {
+            ticks += value;
+        }
+        field = *end == ' ' ? end + 1 : end;
+    }
+    return ticks * 1000.0 / sysconf(_SC_CLK_TCK);
+}
+#endif
+
+} // namespace
+
+bool LoadDispatchJobs(const std::string& path, std::vector<DispatchJob>& jobs) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#') {
+            continue;
+        }
+        char* end = nullptr;
+        long estimate = strtol(line.c_str() + start, &end, 10);
+        size_t command = line.find_first_not_of(" \t", end - line.c_str());
+        if (estimate <= 0 || command == std::string::npos) {
+            return false;
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        jobs.push_back({ line.substr(command), static_cast<int>(estimate) });
+    }
+    return true;
+}
+
+DispatchResult RunDispatch(const std::vector<DispatchJob>& jobs, const DispatchOptions& options) {
+    typedef std::chrono::steady_clock Clock;
+    const size_t count = jobs.size();
+    const int slots = std::max(1, options.slots);
+    const auto quantum = std::chrono::milliseconds(std::max(1, options.quantumMs));
+
+    DispatchResult result;
+    result.processes.resize(count);
+    result.exitCodes.assign(count, -1);
+    for (size_t i = 0; i < count; i++) {
+        result.processes[i] = { ProcessNames().Intern(std::wstring(jobs[i].command.begin(), jobs[i].command.end())),
+            0, jobs[i].estimateMs, 0, 0, 0, false };
+    }
+
+    std::vector<ChildJob> children(count);
+    std::vector<bool> launched(count, false);
+    std::vector<bool> running(count, false);
+    std::vector<int> segmentStart(count, 0);
+    std::vector<size_t> order;
+    size_t completed = 0;
+
+    const Clock::time_point start = Clock::now();
+    auto nowMs = [&]() {
+        return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+    };
+    auto closeSegment = [&](size_t i, int at) {
+        if (at > segmentStart[i]) {
+            result.timeline.push_back({ static_cast<int>(i), segmentStart[i], at - segmentStart[i] });
+        }
+        running[i] = false;
+    };
+
+    while (completed < count) {
+        // Reap exits and refresh the remaining-time estimates
+        int now = nowMs();
+        order.clear();
+        for (size_t i = 0; i < count; i++) {
+            Process& p = result.processes[i];
+            if (p.completed) {
+                continue;
+            }
+            if (launched[i] && children[i].Poll()) {
+                if (running[i]) {
+                    closeSegment(i, now);
+                }
+                p.completed = true;
+                p.burstTime = static_cast<int>(children[i].CpuMs());
+                p.remainingTime = 0;
+                p.turnaroundTime = now;
+                p.waitingTime = std::max(0, now - p.burstTime);
+                result.exitCodes[i] = children[i].ExitCode();
+                completed++;
+                continue;
+            }
+            double used = launched[i] ? children[i].CpuMs() : 0.0;
+            p.remainingTime = std::max(0, jobs[i].estimateMs - static_cast<int>(used));
+            order.push_back(i);
+        }
+        if (completed == count) {
+            break;
+        }
+
+        // The `slots` shortest remaining jobs run; ties go to the lowest index
+        size_t chosen = std::min(order.size(), static_cast<size_t>(slots));
+        std::partial_sort(order.begin(), order.begin() + chosen, order.end(), [&](size_t a, size_t b) {
+            const Process& pa = result.processes[a];
+            const Process& pb = result.processes[b];
+            return pa.remainingTime != pb.remainingTime ? pa.remainingTime < pb.remainingTime : a < b;
+        });
+        for (size_t k = chosen; k < order.size(); k++) {
+            size_t i = order[k];
+            if (running[i]) {
+                children[i].Suspend();
+                closeSegment(i, now);
+                result.preemptions++;
+            }
+        }
+        for (size_t k = 0; k < chosen; k++) {
+            size_t i = order[k];
+            if (running[i]) {
+                continue;
+            }
+            if (!launched[i]) {
+                launched[i] = true;
+                if (!children[i].Launch(jobs[i].command)) {
+                    fprintf(stderr, "dispatch: failed to launch job %zu\n", i);
+                }
+            }
+            else {
+                children[i].Resume();
+            }
+            running[i] = true;
+            segmentStart[i] = now;
+        }
+
+        // Sleep out the quantum, but come back early when a running job exits
+        Clock::time_point deadline = Clock::now() + quantum;
+        auto poll = std::min<Clock::duration>(quantum, std::chrono::milliseconds(5));
+        bool exited = false;
+        while (!exited && Clock::now() < deadline) {
+            std::this_thread::sleep_for(poll);
+            for (size_t k = 0; k < chosen && !exited; k++) {
+                exited = children[order[k]].Poll();
+            }
+        }
+    }
+
+    result.makespanMs = nowMs();
+    std::sort(result.timeline.begin(), result.timeline.end(), [](const RunSegment& a, const RunSegment& b) {
+        return a.startTime != b.startTime ? a.startTime < b.startTime : a.processIndex < b.processIndex;
+    });
+    return result;
+}
+
+void TimelineToSteps(const DispatchResult& result, int quantumMs, std::vector<ExecutionStep>& steps) {
+    steps.clear();
+    int quantum = std::max(1, quantumMs);
+    for (const auto& segment : result.timeline) {
+        int first = segment.startTime / quantum;
+        int last = (segment.startTime + segment.length - 1) / quantum;
+        for (int t = first; t <= last; t++) {
+            steps.push_back({ segment.processIndex, t });
+        }
+    }
+    std::stable_sort(steps.begin(), steps.end(), [](const ExecutionStep& a, const ExecutionStep& b) {
+        return a.timeUnit < b.timeUnit;
+    });
+}
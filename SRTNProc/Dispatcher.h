@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Process.h"
+
+// Real dispatch mode: SRTN applied to actual child processes. Each job is a
+// shell command with an estimated CPU time; the dispatcher keeps at most
+// `slots` of them running, always the ones with the least estimated CPU time
+// left, and parks the rest by suspending them (SIGSTOP/SIGCONT on the job's
+// process group on POSIX, thread suspension inside a job object on Windows).
+struct DispatchJob {
+    std::string command;
+    int estimateMs;
+};
+
+struct DispatchOptions {
+    int slots = 1;
+    int quantumMs = 100;        // Re-decide at least this often
+};
+
+struct DispatchResult {
+    // Times are in milliseconds of wall clock since the run started;
+    // burstTime holds the measured CPU time of the job
+    std::vector<Process> processes;
+    std::vector<int> exitCodes;
+    std::vector<RunSegment> timeline;   // Sorted by start; slots may overlap
+    long long preemptions = 0;
+    int makespanMs = 0;
+};
+
+// Reads "<estimate-ms> <command...>" lines; blank lines and '#' comments are skipped
+bool LoadDispatchJobs(const std::string& path, std::vector<DispatchJob>& jobs);
+
+DispatchResult RunDispatch(const std::vector<DispatchJob>& jobs, const DispatchOptions& options);
+
+// One ExecutionStep per slot per quantum the job held, for the Gantt view
+void TimelineToSteps(const DispatchResult& result, int quantumMs, std::vector<ExecutionStep>& steps);
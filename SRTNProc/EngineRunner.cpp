@@ -0,0 +1,198 @@
+#include "EngineRunner.h"
+
+#include <algorithm>
+#include <climits>
+
+#include "Metrics.h"
+
+namespace {
+
+// RunUntil checks for Stop and Pause between slices of this many time units
+const long long ADVANCE_SLICE = 4096;
+
+} // namespace
+
+EngineRunner::EngineRunner(std::chrono::nanoseconds tick)
+    : m_pacer(tick), m_thread(&EngineRunner::WorkerLoop, this) {
+}
+
+EngineRunner::~EngineRunner() {
+    m_interrupts++;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+        m_state = State::Stopped;
+    }
+    m_changed.notify_all();
+    m_thread.join();
+}
+
+void EngineRunner::SetOptions(const SchedulerOptions& options) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_options = options;
+}
+
+void EngineRunner::SetListener(Listener listener) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_listener = std::move(listener);
+}
+
+void EngineRunner::Load(const std::vector<Process>& processes) {
+    m_interrupts++;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_engine.Reset();
+    m_engine.SetOptions(m_options);
+    for (const auto& process : processes) {
+        m_engine.Submit(process, 0);
+    }
+    m_state = m_engine.HasWork() ? State::Paused : State::Finished;
+}
+
+void EngineRunner::Start(const std::vector<Process>& processes) {
+    Load(processes);
+    Resume();
+}
+
+void EngineRunner::Stop() {
+    m_interrupts++;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_state != State::Finished) {
+            m_state = State::Stopped;
+        }
+    }
+    m_changed.notify_all();
+}
+
+void EngineRunner::Pause() {
+    m_interrupts++;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_state == State::Running) {
+            m_state = State::Paused;
+        }
+    }
+    m_changed.notify_all();
+}
+
+void EngineRunner::Resume() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_state != State::Paused) {
+            return;
+        }
+        m_state = State::Running;
+        // The next tick is the next time unit, due one period from now
+        m_pacer.Start(m_engine.Now());
+    }
+    m_changed.notify_all();
+}
+
+bool EngineRunner::Step() {
+    return RunUntil(Now() + 1);
+}
+
+bool EngineRunner::RunUntil(long long time) {
+    m_interrupts++;
+    unsigned interrupts = m_interrupts;
+    bool working = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_state == State::Finished) {
+            return false;
+        }
+        m_state = State::Paused;
+        working = Advance(std::min<long long>(time, SrtnEngine::MAX_TIME - 1), interrupts);
+    }
+    m_changed.notify_all();
+    Notify(working ? Event::Advanced : Event::Finished);
+    return working;
+}
+
+// Called with the lock held; stops early when another command comes in
+bool EngineRunner::Advance(long long time, unsigned interrupts) {
+    bool working = m_engine.HasWork();
+    while (working && m_engine.Now() < time && m_interrupts == interrupts) {
+        long long until = std::min<long long>(time, m_engine.Now() + ADVANCE_SLICE);
+        long long before = m_engine.Now();
+        working = m_engine.RunBusyUntil(static_cast<int>(until));
+        MetricAdd(Counter::Ticks, static_cast<uint64_t>(m_engine.Now() - before));
+    }
+    if (!working) {
+        m_state = State::Finished;
+    }
+    return working;
+}
+
+bool EngineRunner::Post(const Process& process, Admission* admission, std::vector<int>* shed) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_state == State::Stopped || m_state == State::Finished) {
+        return false;
+    }
+    int index = 0;
+    Admission result = m_engine.Offer(process, index, shed);
+    if (admission != nullptr) {
+        *admission = result;
+    }
+    return true;
+}
+
+EngineRunner::State EngineRunner::GetState() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_state;
+}
+
+long long EngineRunner::Now() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_engine.Now();
+}
+
+void EngineRunner::Snapshot(std::vector<Process>& processes, std::vector<RunSegment>& timeline) {
+    auto waitStart = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MetricObserve(Histogram::LockWaitMicros, std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - waitStart).count());
+    MetricTimer holdTimer(Histogram::LockHoldMicros);
+    processes = m_engine.Processes();
+    timeline = m_engine.Timeline();
+}
+
+void EngineRunner::Notify(Event event) {
+    Listener listener;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        listener = m_listener;
+    }
+    if (listener) {
+        listener(event);
+    }
+}
+
+void EngineRunner::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_quit) {
+        if (m_state != State::Running) {
+            m_changed.wait(lock);
+            continue;
+        }
+        if (m_pacer.DueTick() <= m_engine.Now()) {
+            m_changed.wait_for(lock, m_pacer.UntilNextTick());
+            continue;
+        }
+
+        long long before = m_engine.Now();
+        long long due = std::min<long long>(m_pacer.DueTick(), SrtnEngine::MAX_TIME - 1);
+        bool working = m_engine.RunBusyUntil(static_cast<int>(due));
+        m_pacer.Reached(due);
+        MetricAdd(Counter::Ticks, static_cast<uint64_t>(m_engine.Now() - before));
+        if (!working) {
+            m_state = State::Finished;
+        }
+        Listener listener = m_listener;
+        lock.unlock();
+        if (listener) {
+            listener(working ? Event::Advanced : Event::Finished);
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Scheduler.h"
+#include "TickPacer.h"
+
+// Owns an SrtnEngine and the thread that runs it in real time, one time unit
+// per tick. The worker is joinable and lives as long as the runner. It sleeps
+// on a condition variable until the next tick or a command, so Stop, Pause
+// and Resume take effect within microseconds, not at the next tick. Step and
+// RunUntil advance on the caller's thread, which makes runs scriptable from
+// tests and headless drivers. Every method is safe to call from any thread
+// except the listener.
+class EngineRunner {
+public:
+    enum class State {
+        Stopped,    // No run, or stopped part way; the engine keeps its state
+        Running,    // Advancing one time unit per tick
+        Paused,
+        Finished,   // Every process completed
+    };
+
+    enum class Event {
+        Advanced,
+        Finished,
+    };
+
+    // Called on whichever thread advanced the engine, without the runner's
+    // lock held; it must not call back into the runner
+    typedef std::function<void(Event)> Listener;
+
+    explicit EngineRunner(std::chrono::nanoseconds tick = std::chrono::seconds(1));
+    // Stops the run and joins the worker
+    ~EngineRunner();
+    EngineRunner(const EngineRunner&) = delete;
+    EngineRunner& operator=(const EngineRunner&) = delete;
+
+    void SetOptions(const SchedulerOptions& options);
+    void SetListener(Listener listener);
+
+    // New run of these processes, all ready at time 0. Load leaves it
+    // paused at time 0; Start also sets it running.
+    void Load(const std::vector<Process>& processes);
+    void Start(const std::vector<Process>& processes);
+    // Returns once the worker has let go of the engine; the state stays readable
+    void Stop();
+    void Pause();
+    // The clock picks up from where it paused, without catching up
+    void Resume();
+
+    // Advance exactly one time unit, pausing a running engine first.
+    // Returns false once there is no work left.
+    bool Step();
+    // Advance unpaced until the clock reaches time, then stay paused. Returns
+    // false once there is no work left, or early if stopped meanwhile.
+    bool RunUntil(long long time);
+
+    // Add a process to an active run, arriving at the current time unit.
+    // Returns false, taking nothing, once the run is stopped or finished.
+    // Otherwise admission control decides at once; admission, if given,
+    // says whether the process was admitted, deferred or refused, and shed,
+    // if given, receives the processes dropped to make room for it.
+    bool Post(const Process& process, Admission* admission = nullptr, std::vector<int>* shed = nullptr);
+
+    State GetState() const;
+    long long Now() const;
+    // Copy of the processes and timeline at one instant
+    void Snapshot(std::vector<Process>& processes, std::vector<RunSegment>& timeline);
+
+private:
+    void WorkerLoop();
+    void Notify(Event event);
+    bool Advance(long long time, unsigned interrupts);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    SrtnEngine m_engine;
+    SchedulerOptions m_options;
+    TickPacer m_pacer;
+    Listener m_listener;
+    State m_state = State::Stopped;
+    bool m_quit = false;
+    std::atomic<unsigned> m_interrupts{ 0 };    // Bumped before taking the lock to stop a long RunUntil
+    std::thread m_thread;
+};
@@ -0,0 +1,198 @@
+#include "ExecutorBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Report.h"
+#include "TaskExecutor.h"
+#include "Workload.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Burn CPU rather than sleep so the pool is genuinely busy
+void Spin(int micros) {
+    Clock::time_point until = Clock::now() + std::chrono::microseconds(micros);
+    while (Clock::now() < until) {
+    }
+}
+
+// Baseline: one shared queue, run-to-completion in submission order
+class FifoPool {
+public:
+    explicit FifoPool(int workers) {
+        for (int i = 0; i < workers; i++) {
+            m_threads.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    ~FifoPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    void Submit(std::function<void()> work) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(std::move(work));
+            m_outstanding++;
+        }
+        m_wake.notify_one();
+    }
+
+    void WaitIdle() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this]() { return m_outstanding == 0; });
+    }
+
+private:
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_wake.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;
+            }
+            std::function<void()> work = std::move(m_queue.front());
+            m_queue.pop_front();
+            lock.unlock();
+            work();
+            lock.lock();
+            if (--m_outstanding == 0) {
+                m_idle.notify_all();
+            }
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::deque<std::function<void()>> m_queue;
+    std::vector<std::thread> m_threads;
+    long long m_outstanding = 0;
+    bool m_stopping = false;
+};
+
+struct BenchTask {
+    bool isLong;
+    long long releaseMicros;    // Offset from the start of the run
+};
+
+// Poisson arrivals at the offered load, same sequence for every pool
+std::vector<BenchTask> GenerateBenchTasks(const ExecutorBenchOptions& options) {
+    double meanService = options.longFraction * options.longMicros + (1.0 - options.longFraction) * options.shortMicros;
+    double meanGap = meanService / (options.load * options.workers);
+
+    uint64_t state = options.seed;
+    std::vector<BenchTask> tasks(options.tasks);
+    double clock = 0;
+    for (auto& task : tasks) {
+        double u = (SplitMix64(state) >> 11) * (1.0 / 9007199254740992.0);
+        clock += -std::log(1.0 - u) * meanGap;
+        task.releaseMicros = static_cast<long long>(clock);
+        task.isLong = (SplitMix64(state) >> 11) * (1.0 / 9007199254740992.0) < options.longFraction;
+    }
+    return tasks;
+}
+
+// Releases every task on schedule through submit(index), then collects latencies
+template <typename SubmitFn, typename WaitFn>
+ExecutorBenchResult RunBench(const ExecutorBenchOptions& options, SubmitFn submit, WaitFn wait) {
+    std::vector<BenchTask> tasks = GenerateBenchTasks(options);
+    std::vector<long long> done(tasks.size());
+
+    Clock::time_point start = Clock::now();
+    auto elapsed = [start]() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    };
+
+    for (size_t i = 0; i < tasks.size(); i++) {
+        long long ahead = tasks[i].releaseMicros - elapsed();
+        if (ahead > 1000) {
+            std::this_thread::sleep_for(std::chrono::microseconds(ahead - 500));
+        }
+        while (elapsed() < tasks[i].releaseMicros) {
+            std::this_thread::yield();
+        }
+        submit(tasks[i].isLong, [&done, &elapsed, i]() { done[i] = elapsed(); });
+    }
+    wait();
+
+    ExecutorBenchResult result;
+    result.seconds = elapsed() / 1e6;
+    std::vector<int> shortLatency;
+    std::vector<int> longLatency;
+    double total = 0;
+    for (size_t i = 0; i < tasks.size(); i++) {
+        int latency = static_cast<int>(done[i] - tasks[i].releaseMicros);
+        total += latency;
+        result.maxAll = std::max(result.maxAll, latency);
+        (tasks[i].isLong ? longLatency : shortLatency).push_back(latency);
+    }
+    result.meanAll = tasks.empty() ? 0 : total / tasks.size();
+    result.p50Short = Percentile(shortLatency, 50);
+    result.p99Short = Percentile(shortLatency, 99);
+    result.p99Long = Percentile(longLatency, 99);
+    return result;
+}
+
+} // namespace
+
+ExecutorBenchResult RunFifoPoolBenchmark(const ExecutorBenchOptions& options) {
+    FifoPool pool(options.workers);
+    return RunBench(options, [&](bool isLong, std::function<void()> finished) {
+        int micros = isLong ? options.longMicros : options.shortMicros;
+        pool.Submit([micros, finished]() {
+            Spin(micros);
+            finished();
+        });
+    }, [&]() { pool.WaitIdle(); });
+}
+
+ExecutorBenchResult RunTaskExecutorBenchmark(const ExecutorBenchOptions& options) {
+    TaskExecutor executor(options.workers);
+    ExecutorBenchResult result = RunBench(options, [&](bool isLong, std::function<void()> finished) {
+        if (!isLong) {
+            executor.Submit([&options, finished]() {
+                Spin(options.shortMicros);
+                finished();
+            }, options.shortMicros);
+            return;
+        }
+        executor.SubmitChunked([&options, finished](long long& remaining) {
+            int chunk = static_cast<int>(std::min<long long>(remaining, options.chunkMicros));
+            Spin(chunk);
+            remaining -= chunk;
+            if (remaining > 0) {
+                return false;
+            }
+            finished();
+            return true;
+        }, options.longMicros);
+    }, [&]() { executor.WaitIdle(); });
+
+    TaskExecutor::Stats stats = executor.GetStats();
+    printf("executor: %lld tasks, %lld chunks, %lld steals, %lld preemptions\n",
+        stats.tasks, stats.chunks, stats.steals, stats.preemptions);
+    return result;
+}
+
+void PrintExecutorBench(const char* label, const ExecutorBenchResult& result) {
+    printf("%s: latency us mean %.0f, short p50 %d p99 %d, long p99 %d, max %d (%.2f s)\n", label,
+        result.meanAll, result.p50Short, result.p99Short, result.p99Long, result.maxAll, result.seconds);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// Open-arrival benchmark of TaskExecutor against a plain FIFO thread pool.
+// A producer releases a mix of short tasks and long chunked tasks at a fixed
+// offered load; latency is measured from each task's release to its completion.
+struct ExecutorBenchOptions {
+    int workers = 4;
+    int tasks = 20000;
+    double load = 0.8;              // Offered CPU load relative to the pool size
+    double longFraction = 0.05;
+    int shortMicros = 50;
+    int longMicros = 5000;
+    int chunkMicros = 250;          // Preemption granularity of long tasks
+    uint64_t seed = 1;
+};
+
+struct ExecutorBenchResult {
+    // Latencies in microseconds
+    double meanAll = 0;
+    int p50Short = 0;
+    int p99Short = 0;
+    int p99Long = 0;
+    int maxAll = 0;
+    double seconds = 0;
+};
+
+ExecutorBenchResult RunFifoPoolBenchmark(const ExecutorBenchOptions& options);
+ExecutorBenchResult RunTaskExecutorBenchmark(const ExecutorBenchOptions& options);
+
+void PrintExecutorBench(const char* label, const ExecutorBenchResult& result);
@@ -0,0 +1,246 @@
+#include "FairShare.h"
+
+#include <algorithm>
+
+namespace {
+
+// Pass advance per unit of CPU at weight 1
+const long long STRIDE_ONE = 1 << 20;
+
+template <typename Entry>
+bool ShorterAfter(const Entry& a, const Entry& b) {
+    if (a.remaining != b.remaining) {
+        return a.remaining > b.remaining;
+    }
+    return a.index > b.index;
+}
+
+template <typename Entry>
+bool PassAfter(const Entry& a, const Entry& b) {
+    if (a.pass != b.pass) {
+        return a.pass > b.pass;
+    }
+    return a.group > b.group;
+}
+
+} // namespace
+
+template <typename Time, typename Index>
+int BasicFairShareEngine<Time, Index>::AddGroup(int weight) {
+    weight = std::max(1, weight);
+    m_groupState.push_back({ STRIDE_ONE / weight, 0, false, {} });
+    m_stats.emplace_back();
+    m_stats.back().weight = weight;
+    return static_cast<int>(m_groupState.size()) - 1;
+}
+
+template <typename Time, typename Index>
+void BasicFairShareEngine<Time, Index>::Reset() {
+    m_processes.clear();
+    m_arrival.clear();
+    m_group.clear();
+    m_pending.clear();
+    m_groups.clear();
+    m_timeline.clear();
+    for (size_t g = 0; g < m_groupState.size(); g++) {
+        m_groupState[g].pass = 0;
+        m_groupState[g].active = false;
+        m_groupState[g].ready.clear();
+        int weight = m_stats[g].weight;
+        m_stats[g] = GroupStats();
+        m_stats[g].weight = weight;
+    }
+    m_running = NO_PROCESS;
+    m_runningGroup = -1;
+    m_sliceLeft = 0;
+    m_virtual = 0;
+    m_preemptions = 0;
+    m_now = 0;
+}
+
+template <typename Time, typename Index>
+Index BasicFairShareEngine<Time, Index>::Submit(const ProcessType& process, Time arrivalTime, int group) {
+    Index index = static_cast<Index>(m_processes.size());
+    m_processes.push_back(process);
+    m_arrival.push_back(std::max(arrivalTime, m_now));
+    m_group.push_back(group);
+
+    auto later = [this](Index a, Index b) { return ArrivesBefore(b, a); };
+    m_pending.push_back(index);
+    std::push_heap(m_pending.begin(), m_pending.end(), later);
+    return index;
+}
+
+template <typename Time, typename Index>
+bool BasicFairShareEngine<Time, Index>::ArrivesBefore(Index a, Index b) const {
+    if (m_arrival[a] != m_arrival[b]) {
+        return m_arrival[a] < m_arrival[b];
+    }
+    return a < b;
+}
+
+// Queue a process in its group, activating the group if it was idle
+template <typename Time, typename Index>
+void BasicFairShareEngine<Time, Index>::MakeReady(Index index) {
+    int g = m_group[index];
+    Group& group = m_groupState[g];
+    group.ready.push_back({ m_processes[index].remainingTime, index });
+    std::push_heap(group.ready.begin(), group.ready.end(), ShorterAfter<ReadyEntry>);
+    if (!group.active) {
+        group.active = true;
+        group.pass = std::max(group.pass, m_virtual);
+        m_groups.push_back({ group.pass, g });
+        std::push_heap(m_groups.begin(), m_groups.end(), PassAfter<GroupEntry>);
+    }
+}
+
+template <typename Time, typename Index>
+void BasicFairShareEngine<Time, Index>::AdmitArrivals() {
+    auto later = [this](Index a, Index b) { return ArrivesBefore(b, a); };
+
+    while (!m_pending.empty() && m_arrival[m_pending.front()] <= m_now) {
+        std::pop_heap(m_pending.begin(), m_pending.end(), later);
+        Index index = m_pending.back();
+        m_pending.pop_back();
+
+        if (m_processes[index].remainingTime <= 0) {
+            Complete(index);
+            continue;
+        }
+        MakeReady(index);
+
+        // SRTN within the running group: a shorter arrival takes over the rest of the slice
+        if (m_running != NO_PROCESS && m_group[index] == m_runningGroup) {
+            Group& group = m_groupState[m_runningGroup];
+            const ReadyEntry& top = group.ready.front();
+            Time running = m_processes[m_running].remainingTime;
+            if (top.remaining < running || (top.remaining == running && top.index < m_running)) {
+                Index next = top.index;
+                std::pop_heap(group.ready.begin(), group.ready.end(), ShorterAfter<ReadyEntry>);
+                group.ready.pop_back();
+                group.ready.push_back({ running, m_running });
+                std::push_heap(group.ready.begin(), group.ready.end(), ShorterAfter<ReadyEntry>);
+                m_running = next;
+                m_preemptions++;
+            }
+        }
+    }
+}
+
+// Give the CPU to the active group with the lowest pass, and to its shortest process
+template <typename Time, typename Index>
+bool BasicFairShareEngine<Time, Index>::PickGroup() {
+    if (m_groups.empty()) {
+        return false;
+    }
+    std::pop_heap(m_groups.begin(), m_groups.end(), PassAfter<GroupEntry>);
+    int g = m_groups.back().group;
+    m_groups.pop_back();
+
+    Group& group = m_groupState[g];
+    std::pop_heap(group.ready.begin(), group.ready.end(), ShorterAfter<ReadyEntry>);
+    m_running = group.ready.back().index;
+    group.ready.pop_back();
+    m_runningGroup = g;
+    m_sliceLeft = m_options.quantum > 0 ? static_cast<Time>(m_options.quantum) : std::numeric_limits<Time>::max();
+    m_virtual = group.pass;
+    m_stats[g].selections++;
+    return true;
+}
+
+// The running group's slice is over: its process goes back to the group,
+// and the group back to the queue at its new pass if it has work left
+template <typename Time, typename Index>
+void BasicFairShareEngine<Time, Index>::Requeue() {
+    Group& group = m_groupState[m_runningGroup];
+    if (m_running != NO_PROCESS) {
+        group.ready.push_back({ m_processes[m_running].remainingTime, m_running });
+        std::push_heap(group.ready.begin(), group.ready.end(), ShorterAfter<ReadyEntry>);
+        m_running = NO_PROCESS;
+    }
+    if (group.ready.empty()) {
+        group.active = false;
+    }
+    else {
+        m_groups.push_back({ group.pass, m_runningGroup });
+        std::push_heap(m_groups.begin(), m_groups.end(), PassAfter<GroupEntry>);
+    }
+    m_runningGroup = -1;
+}
+
+template <typename Time, typename Index>
+void BasicFairShareEngine<Time, Index>::Execute(Time length) {
+    if (!m_timeline.empty() &&
+        m_timeline.back().processIndex == m_running &&
+        m_timeline.back().startTime + m_timeline.back().length == m_now) {
+        m_timeline.back().length += length;
+    }
+    else {
+        m_timeline.push_back({ m_running, m_now, length });
+    }
+    m_now += length;
+    m_sliceLeft -= length;
+    m_groupState[m_runningGroup].pass += static_cast<long long>(length) * m_groupState[m_runningGroup].stride;
+    m_stats[m_runningGroup].busyTime += length;
+
+    ProcessType& p = m_processes[m_running];
+    p.remainingTime -= length;
+    if (p.remainingTime == 0) {
+        Complete(m_running);
+        m_running = NO_PROCESS;
+        Requeue();
+    }
+    else if (m_sliceLeft == 0) {
+        Requeue();
+    }
+}
+
+template <typename Time, typename Index>
+void BasicFairShareEngine<Time, Index>::Complete(Index index) {
+    ProcessType& p = m_processes[index];
+    p.completed = true;
+    p.turnaroundTime = m_now - m_arrival[index];
+    p.waitingTime = p.turnaroundTime - p.burstTime;
+    m_stats[m_group[index]].completed++;
+}
+
+template <typename Time, typename Index>
+void BasicFairShareEngine<Time, Index>::RunToCompletion() {
+    for (;;) {
+        AdmitArrivals();
+        if (m_running == NO_PROCESS && !PickGroup()) {
+            if (m_pending.empty()) {
+                return;
+            }
+            m_now = m_arrival[m_pending.front()];
+            continue;
+        }
+
+        // Run until completion, the end of the slice or the next arrival
+        Time until = m_now + std::min(m_processes[m_running].remainingTime, m_sliceLeft);
+        if (!m_pending.empty()) {
+            until = std::min(until, m_arrival[m_pending.front()]);
+        }
+        Execute(until - m_now);
+    }
+}
+
+template <typename Time, typename Index>
+size_t BasicFairShareEngine<Time, Index>::MemoryUsage() const {
+    size_t bytes = m_processes.capacity() * sizeof(ProcessType) +
+        m_arrival.capacity() * sizeof(Time) +
+        m_group.capacity() * sizeof(int) +
+        m_pending.capacity() * sizeof(Index) +
+        m_groups.capacity() * sizeof(GroupEntry) +
+        m_timeline.capacity() * sizeof(Segment);
+    for (const auto& group : m_groupState) {
+        bytes += sizeof(Group) + group.ready.capacity() * sizeof(ReadyEntry);
+    }
+    return bytes;
+}
+
+template class BasicFairShareEngine<int, int>;
+template class BasicFairShareEngine<int32_t, uint16_t>;
+template class BasicFairShareEngine<int32_t, uint32_t>;
+template class BasicFairShareEngine<int64_t, uint16_t>;
+template class BasicFairShareEngine<int64_t, uint32_t>;
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Process.h"
+
+struct FairShareOptions {
+    int quantum = 20;   // CPU time a group gets per selection; 0 lets each job run to completion
+};
+
+struct GroupStats {
+    int weight = 1;
+    long long busyTime = 0;     // CPU time the group's processes received
+    long long completed = 0;
+    long long selections = 0;   // Times the group was given the CPU
+};
+
+// Two-level scheduler for tenants sharing one CPU. Stride scheduling picks a
+// group: each group's pass advances by the CPU time it uses divided by its
+// weight, and the active group with the lowest pass runs next, for up to one
+// quantum. SRTN picks the process within the group and preempts on arrivals
+// into the running group. Arrivals into other groups wait for the quantum,
+// so a tenant with many short jobs gets its weighted share, not the CPU.
+// A group that was idle rejoins at the current pass rather than its old one,
+// so idle time earns no credit. Choosing a group is a heap operation,
+// O(log groups).
+template <typename Time, typename Index>
+class BasicFairShareEngine {
+public:
+    typedef BasicProcess<Time> ProcessType;
+    typedef BasicRunSegment<Time, Index> Segment;
+
+    static constexpr Index NO_PROCESS = std::numeric_limits<Index>::max();
+
+    void SetOptions(const FairShareOptions& options) { m_options = options; }
+    // Returns the new group's number; weights below 1 count as 1
+    int AddGroup(int weight);
+    // Clears processes and group history; the groups stay configured
+    void Reset();
+
+    // Indices are assigned in submission order. The group must exist.
+    Index Submit(const ProcessType& process, Time arrivalTime, int group);
+    void RunToCompletion();
+
+    Time Now() const { return m_now; }
+    Index Running() const { return m_running; }
+    size_t ProcessCount() const { return m_processes.size(); }
+    const std::vector<ProcessType>& Processes() const { return m_processes; }
+    const std::vector<Segment>& Timeline() const { return m_timeline; }
+    int GroupOf(Index index) const { return m_group[index]; }
+    const std::vector<GroupStats>& Groups() const { return m_stats; }
+    long long Preemptions() const { return m_preemptions; }
+    size_t MemoryUsage() const;
+
+private:
+    // Remaining time is fixed while a process waits, so entries never go stale
+    struct ReadyEntry {
+        Time remaining;
+        Index index;
+    };
+
+    struct GroupEntry {
+        long long pass;
+        int group;
+    };
+
+    struct Group {
+        long long stride;
+        long long pass;
+        bool active;                    // Queued in m_groups or running
+        std::vector<ReadyEntry> ready;  // min-heap by (remaining, index)
+    };
+
+    void AdmitArrivals();
+    void MakeReady(Index index);
+    bool PickGroup();
+    void Requeue();
+    void Execute(Time length);
+    void Complete(Index index);
+    bool ArrivesBefore(Index a, Index b) const;
+
+    FairShareOptions m_options;
+    std::vector<ProcessType> m_processes;
+    std::vector<Time> m_arrival;
+    std::vector<int> m_group;
+    std::vector<Index> m_pending;       // min-heap by (arrival, index)
+    std::vector<Group> m_groupState;
+    std::vector<GroupStats> m_stats;
+    std::vector<GroupEntry> m_groups;   // Active groups, min-heap by (pass, group)
+    std::vector<Segment> m_timeline;
+    Index m_running = NO_PROCESS;
+    int m_runningGroup = -1;
+    Time m_sliceLeft = 0;
+    long long m_virtual = 0;            // Pass of the last group selected
+    long long m_preemptions = 0;
+    Time m_now = 0;
+};
+
+typedef BasicFairShareEngine<int, int> FairShareEngine;
@@ -0,0 +1,1809 @@
+#include "Headless.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cwchar>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#include "BurstPredictor.h"
+#include "Checkpoint.h"
+#include "Dispatcher.h"
+#include "EngineRunner.h"
+#include "ExecutorBenchmark.h"
+#include "FairShare.h"
+#include "Metrics.h"
+#include "Report.h"
+#include "ScanEngine.h"
+#include "ScheduleGenerator.h"
+#include "SchedulerService.h"
+#include "SelectKernel.h"
+#include "TickPacer.h"
+#include "TimelineFile.h"
+#include "TimelineIndex.h"
+#include "TraceFile.h"
+#include "Verify.h"
+#include "WhatIf.h"
+#include "Workload.h"
+
+namespace {
+
+// Value following a "--name" switch, or fallback when absent
+std::wstring GetOption(const std::vector<std::wstring>& args, const wchar_t* name, const std::wstring& fallback) {
+    for (size_t i = 1; i + 1 < args.size(); i++) {
+        if (args[i] == name) {
+            return args[i + 1];
+        }
+    }
+    return fallback;
+}
+
+unsigned long long GetNumber(const std::vector<std::wstring>& args, const wchar_t* name, unsigned long long fallback) {
+    std::wstring value = GetOption(args, name, L"");
+    return value.empty() ? fallback : wcstoull(value.c_str(), nullptr, 10);
+}
+
+double GetDouble(const std::vector<std::wstring>& args, const wchar_t* name, double fallback) {
+    std::wstring value = GetOption(args, name, L"");
+    return value.empty() ? fallback : wcstod(value.c_str(), nullptr);
+}
+
+// Comma-separated list of integers, e.g. "0,1,2,4"
+std::vector<int> GetList(const std::vector<std::wstring>& args, const wchar_t* name, int fallback) {
+    std::wstring value = GetOption(args, name, L"");
+    std::vector<int> list;
+    const wchar_t* cursor = value.c_str();
+    while (*cursor != L'\0') {
+        wchar_t* end = nullptr;
+        list.push_back(static_cast<int>(wcstol(cursor, &end, 10)));
+        cursor = *end == L',' ? end + 1 : end;
+        if (end == cursor && *cursor != L'\0') {
+            break;
+        }
+    }
+    if (list.empty()) {
+        list.push_back(fallback);
+    }
+    return list;
+}
+
+// Comma-separated list of reals, e.g. "0.2,0.5,0.8"
+std::vector<double> GetDoubleList(const std::vector<std::wstring>& args, const wchar_t* name, double fallback) {
+    std::wstring value = GetOption(args, name, L"");
+    std::vector<double> list;
+    const wchar_t* cursor = value.c_str();
+    while (*cursor != L'\0') {
+        wchar_t* end = nullptr;
+        list.push_back(wcstod(cursor, &end));
+        cursor = *end == L',' ? end + 1 : end;
+        if (end == cursor && *cursor != L'\0') {
+            break;
+        }
+    }
+    if (list.empty()) {
+        list.push_back(fallback);
+    }
+    return list;
+}
+
+// Paths and names on the command line are expected to be ASCII
+std::string Narrow(const std::wstring& text) {
+    return std::string(text.begin(), text.end());
+}
+
+// "none", "edf", "slack" or "llf"; false for anything else
+bool ParseDeadlineMode(const std::wstring& name, DeadlineMode& mode) {
+    static const struct {
+        const wchar_t* name;
+        DeadlineMode mode;
+    } MODES[] = {
+        { L"none", DeadlineMode::None },
+        { L"edf", DeadlineMode::Edf },
+        { L"slack", DeadlineMode::Slack },
+        { L"llf", DeadlineMode::LeastLaxity },
+    };
+    for (const auto& entry : MODES) {
+        if (name == entry.name) {
+            mode = entry.mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+// "unbounded", "reject", "defer" or "shed"; false for anything else
+bool ParseAdmissionPolicy(const std::wstring& name, AdmissionPolicy& policy) {
+    static const struct {
+        const wchar_t* name;
+        AdmissionPolicy policy;
+    } POLICIES[] = {
+        { L"unbounded", AdmissionPolicy::Unbounded },
+        { L"reject", AdmissionPolicy::Reject },
+        { L"defer", AdmissionPolicy::Defer },
+        { L"shed", AdmissionPolicy::ShedLongest },
+    };
+    for (const auto& entry : POLICIES) {
+        if (name == entry.name) {
+            policy = entry.policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+SchedulerOptions GetSchedulerOptions(const std::vector<std::wstring>& args) {
+    SchedulerOptions options;
+    options.switchCost = static_cast<int>(GetNumber(args, L"--switch-cost", options.switchCost));
+    options.preemptThreshold = static_cast<int>(GetNumber(args, L"--threshold", options.preemptThreshold));
+    options.agingPeriod = static_cast<int>(GetNumber(args, L"--aging", options.agingPeriod));
+    options.maxWait = static_cast<int>(GetNumber(args, L"--max-wait", options.maxWait));
+    ParseDeadlineMode(GetOption(args, L"--deadline-mode", L"none"), options.deadlineMode);
+    options.slackThreshold = static_cast<int>(GetNumber(args, L"--slack-threshold", options.slackThreshold));
+    ParseAdmissionPolicy(GetOption(args, L"--admission-policy", L"unbounded"), options.admission);
+    options.maxReady = static_cast<int>(GetNumber(args, L"--max-ready", options.maxReady));
+    options.maxOutstanding = static_cast<long long>(GetNumber(args, L"--max-work", options.maxOutstanding));
+    return options;
+}
+
+WorkloadOptions GetWorkloadOptions(const std::vector<std::wstring>& args) {
+    WorkloadOptions options;
+    options.count = static_cast<int>(GetNumber(args, L"--processes", options.count));
+    options.seed = GetNumber(args, L"--seed", options.seed);
+    options.meanBurst = static_cast<int>(GetNumber(args, L"--mean-burst", options.meanBurst));
+    options.load = GetDouble(args, L"--load", options.load);
+    options.classes = static_cast<int>(GetNumber(args, L"--classes", options.classes));
+    options.deadlineStretch = GetDouble(args, L"--deadline-stretch", options.deadlineStretch);
+    options.deadlineShare = GetDouble(args, L"--deadline-share", options.deadlineShare);
+    return options;
+}
+
+// Jobs alternating CPU and I/O, for the modes that set up devices
+void GetIoOptions(const std::vector<std::wstring>& args, WorkloadOptions& options) {
+    options.devices = static_cast<int>(GetNumber(args, L"--devices", options.devices));
+    options.ioBursts = GetDouble(args, L"--io-bursts", options.ioBursts);
+    options.meanIo = static_cast<int>(GetNumber(args, L"--mean-io", options.meanIo));
+}
+
+// --trace FILE loads the workload from a CSV trace; otherwise one is generated
+bool GetWorkload(const std::vector<std::wstring>& args, Workload& workload) {
+    std::wstring trace = GetOption(args, L"--trace", L"");
+    if (trace.empty()) {
+        GenerateWorkload(GetWorkloadOptions(args), workload);
+        return true;
+    }
+    TraceLoadStats stats;
+    std::string error;
+    if (!LoadTrace(Narrow(trace), static_cast<int>(GetNumber(args, L"--threads", 0)), workload, stats, error)) {
+        fprintf(stderr, "trace: %s\n", error.c_str());
+        return false;
+    }
+    return true;
+}
+
+// The widths WithEngineFor chose and what the engine held per process
+template <typename Engine>
+void PrintEngineWidths(const char* mode, const Engine& engine) {
+    printf("%s: %zu-bit time, %zu-bit index, %.1f engine bytes/process\n", mode,
+        sizeof(engine.Now()) * 8, sizeof(engine.Running()) * 8,
+        engine.ProcessCount() > 0 ? static_cast<double>(engine.MemoryUsage()) / engine.ProcessCount() : 0.0);
+}
+
+// Run a synthetic workload once per preemption threshold so switch overhead
+// can be traded against responsiveness
+int RunSimulate(const std::vector<std::wstring>& args) {
+    Workload workload;
+    if (!GetWorkload(args, workload)) {
+        return 1;
+    }
+
+    SchedulerOptions options = GetSchedulerOptions(args);
+    WithEngineFor(workload, options, [&](auto& engine) {
+        for (int value : GetList(args, L"--thresholds", options.preemptThreshold)) {
+            options.preemptThreshold = value;
+            engine.Reset();
+            engine.SetOptions(options);
+            SubmitWorkload(workload, engine);
+            engine.RunToCompletion();
+
+            char label[64];
+            snprintf(label, sizeof(label), "cost=%d threshold=%d", options.switchCost, value);
+            PrintSummary(label, Summarize(engine.Processes(), engine.Now()));
+            PrintStats(label, engine.Stats(), engine.Now());
+        }
+        PrintEngineWidths("simulate", engine);
+    });
+    return 0;
+}
+
+// Back-to-back runs through one engine, cycling through the thresholds as a
+// parameter sweep would. Reset keeps every buffer, so once each threshold has
+// run the later runs should make no heap allocations; this measures that.
+int RunSweep(const std::vector<std::wstring>& args) {
+    Workload workload;
+    if (!GetWorkload(args, workload)) {
+        return 1;
+    }
+    int runs = std::max(1, static_cast<int>(GetNumber(args, L"--runs", 1000)));
+    std::vector<int> thresholds = GetOption(args, L"--thresholds", L"").empty() ?
+        std::vector<int>{ 0, 2, 5 } : GetList(args, L"--thresholds", 0);
+
+    SchedulerOptions options = GetSchedulerOptions(args);
+    WithEngineFor(workload, options, [&](auto& engine) {
+        auto run = [&](int threshold) {
+            options.preemptThreshold = threshold;
+            engine.Reset();
+            engine.SetOptions(options);
+            SubmitWorkload(workload, engine);
+            engine.RunToCompletion();
+        };
+        uint64_t before = HeapAllocations();
+        for (int threshold : thresholds) {
+            run(threshold);
+        }
+        uint64_t warmup = HeapAllocations() - before;
+
+        auto start = std::chrono::steady_clock::now();
+        before = HeapAllocations();
+        for (int i = 0; i < runs; i++) {
+            run(thresholds[i % thresholds.size()]);
+        }
+        uint64_t steady = HeapAllocations() - before;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        printf("sweep: %zu warm-up runs made %llu heap allocations\n", thresholds.size(),
+            static_cast<unsigned long long>(warmup));
+        printf("sweep: %d runs of %zu processes, %.1f us/run, %.2f heap allocations/run\n", runs,
+            workload.processes.size(), seconds * 1e6 / runs, static_cast<double>(steady) / runs);
+        PrintEngineWidths("sweep", engine);
+    });
+    return 0;
+}
+
+// Generate a workload and write it as a CSV trace for --trace and --load-trace
+int RunWriteTrace(const std::vector<std::wstring>& args) {
+    std::string path = Narrow(GetOption(args, L"--write-trace", L""));
+    if (path.empty()) {
+        fprintf(stderr, "write-trace: expected a file name\n");
+        return 1;
+    }
+    Workload workload;
+    GenerateWorkload(GetWorkloadOptions(args), workload);
+    auto start = std::chrono::steady_clock::now();
+    std::string error;
+    if (!SaveTrace(path, workload, error)) {
+        fprintf(stderr, "write-trace: %s\n", error.c_str());
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("write-trace: %zu processes to %s in %.3f s\n", workload.processes.size(), path.c_str(), seconds);
+    return 0;
+}
+
+// Load a trace once per thread count, reporting throughput by phase, and
+// check that every thread count produced the same workload
+int RunLoadTrace(const std::vector<std::wstring>& args) {
+    std::string path = Narrow(GetOption(args, L"--load-trace", L""));
+    int failures = 0;
+    uint64_t first = 0;
+    for (int threads : GetList(args, L"--threads", 0)) {
+        Workload workload;
+        TraceLoadStats stats;
+        std::string error;
+        if (!LoadTrace(path, threads, workload, stats, error)) {
+            fprintf(stderr, "load-trace: %s\n", error.c_str());
+            return 1;
+        }
+        uint64_t digest = 14695981039346656037ULL;
+        for (size_t i = 0; i < workload.processes.size(); i++) {
+            digest = (digest ^ static_cast<uint64_t>(workload.arrivalTimes[i])) * 1099511628211ULL;
+            digest = (digest ^ static_cast<uint64_t>(workload.processes[i].burstTime)) * 1099511628211ULL;
+            digest = (digest ^ workload.processes[i].name) * 1099511628211ULL;
+        }
+        double seconds = stats.mapSeconds + stats.parseSeconds + stats.mergeSeconds;
+        printf("load-trace: %d threads, %d chunks: %zu processes, %.1f MB in %.3f s (%.2f GB/s), "
+            "parse %.3f s, merge %.3f s, %s, digest %016llx\n",
+            threads, stats.chunks, stats.processes, stats.bytes / (1024.0 * 1024.0), seconds,
+            seconds > 0 ? stats.bytes / seconds / 1e9 : 0.0, stats.parseSeconds, stats.mergeSeconds,
+            stats.sorted ? "in arrival order" : "merged by arrival", static_cast<unsigned long long>(digest));
+        if (first == 0) {
+            first = digest;
+        }
+        else if (digest != first) {
+            printf("load-trace: %d threads loaded a different workload\n", threads);
+            failures++;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+// FNV-1a over the timeline and every process's accounting: two runs with the
+// same digest scheduled identically
+template <typename Segment, typename Process>
+uint64_t RunDigest(const std::vector<Segment>& timeline, const std::vector<Process>& processes) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](long long value) {
+        for (int i = 0; i < 8; i++) {
+            hash = (hash ^ static_cast<unsigned char>(value >> (8 * i))) * 1099511628211ULL;
+        }
+    };
+    for (const auto& segment : timeline) {
+        mix(static_cast<long long>(segment.processIndex));
+        mix(segment.startTime);
+        mix(segment.length);
+    }
+    for (const auto& process : processes) {
+        mix(process.waitingTime);
+        mix(process.turnaroundTime);
+    }
+    return hash;
+}
+
+template <typename Engine>
+uint64_t RunDigest(Engine& engine) {
+    return RunDigest(engine.Timeline(), engine.Processes());
+}
+
+// Plain SRTN against each aging period and each wait bound: what the tail
+// gains and what mean turnaround pays for it
+int RunStarvation(const std::vector<std::wstring>& args) {
+    Workload workload;
+    GenerateWorkload(GetWorkloadOptions(args), workload);
+
+    SchedulerOptions base = GetSchedulerOptions(args);
+    base.agingPeriod = 0;
+    base.maxWait = 0;
+
+    // Without lists, each remedy at a strong and a mild setting
+    std::vector<int> periods = GetOption(args, L"--aging-periods", L"").empty() ?
+        std::vector<int>{ 8, 32 } : GetList(args, L"--aging-periods", 0);
+    std::vector<int> waits = GetOption(args, L"--max-waits", L"").empty() ?
+        std::vector<int>{ 500, 2000 } : GetList(args, L"--max-waits", 0);
+    std::vector<SchedulerOptions> variants;
+    for (int period : periods) {
+        if (period > 0) {
+            variants.push_back(base);
+            variants.back().agingPeriod = period;
+        }
+    }
+    for (int wait : waits) {
+        if (wait > 0) {
+            variants.push_back(base);
+            variants.back().maxWait = wait;
+        }
+    }
+    // Every remedy also runs with a switch cost, where a process chosen by
+    // aging must still get to run once its switch is paid for
+    std::vector<int> costs = GetOption(args, L"--switch-cost", L"").empty() ?
+        std::vector<int>{ 0, 1 } : std::vector<int>{ base.switchCost };
+    // Each remedy is run again in slices of these many time units, as a
+    // checkpointed or paced run would be, and must schedule identically
+    std::vector<int> slices = GetOption(args, L"--slices", L"").empty() ?
+        std::vector<int>{ 1000, 7777 } : GetList(args, L"--slices", 0);
+
+    int failures = 0;
+    WithEngineFor(workload, base, [&](auto& engine) {
+        for (int cost : costs) {
+            SchedulerOptions plainOptions = base;
+            plainOptions.switchCost = cost;
+            engine.Reset();
+            engine.SetOptions(plainOptions);
+            SubmitWorkload(workload, engine);
+            engine.RunToCompletion();
+            RunSummary plain = Summarize(engine.Processes(), engine.Now());
+            char label[64];
+            snprintf(label, sizeof(label), "srtn switch=%d", cost);
+            PrintSummary(label, plain);
+
+            for (SchedulerOptions options : variants) {
+                options.switchCost = cost;
+                engine.Reset();
+                engine.SetOptions(options);
+                SubmitWorkload(workload, engine);
+                engine.RunToCompletion();
+
+                snprintf(label, sizeof(label), "aging=%d max-wait=%d switch=%d", options.agingPeriod, options.maxWait, cost);
+                RunSummary summary = Summarize(engine.Processes(), engine.Now());
+                PrintSummary(label, summary);
+                printf("%s: mean turnaround %+.1f%%, p99.9 %+.1f%%, max %+.1f%% vs srtn, %lld forced dispatches\n", label,
+                    plain.meanTurnaround > 0 ? 100.0 * (summary.meanTurnaround / plain.meanTurnaround - 1) : 0.0,
+                    plain.p999Turnaround > 0 ? 100.0 * (static_cast<double>(summary.p999Turnaround) / plain.p999Turnaround - 1) : 0.0,
+                    plain.maxTurnaround > 0 ? 100.0 * (static_cast<double>(summary.maxTurnaround) / plain.maxTurnaround - 1) : 0.0,
+                    engine.Stats().forced);
+                if (engine.CompletedCount() != workload.processes.size()) {
+                    printf("%s: only %zu of %zu processes completed\n", label, engine.CompletedCount(),
+                        workload.processes.size());
+                    failures++;
+                }
+
+                uint64_t digest = RunDigest(engine);
+                for (int slice : slices) {
+                    if (slice <= 0) {
+                        continue;
+                    }
+                    engine.Reset();
+                    engine.SetOptions(options);
+                    SubmitWorkload(workload, engine);
+                    long long until = 0;
+                    do {
+                        until = std::min<long long>(until + slice, engine.MAX_TIME - 1);
+                    } while (engine.RunUntil(static_cast<decltype(engine.Now())>(until)));
+                    if (RunDigest(engine) != digest) {
+                        printf("%s: run in slices of %d schedules differently\n", label, slice);
+                        failures++;
+                    }
+                }
+            }
+        }
+        PrintEngineWidths("starvation", engine);
+    });
+    return failures == 0 ? 0 : 1;
+}
+
+// The same jobs with deadlines under plain SRTN and each deadline mode:
+// miss rate, tardiness and what the mean turnaround pays for them
+int RunDeadlines(const std::vector<std::wstring>& args) {
+    WorkloadOptions workloadOptions = GetWorkloadOptions(args);
+    workloadOptions.deadlineStretch = GetDouble(args, L"--deadline-stretch", 1.0);
+    Workload workload;
+    GenerateWorkload(workloadOptions, workload);
+
+    std::vector<DeadlineMode> modes;
+    std::wstring list = GetOption(args, L"--modes", L"none,edf,slack,llf");
+    for (size_t start = 0; start <= list.size();) {
+        size_t end = std::min(list.find(L',', start), list.size());
+        std::wstring name = list.substr(start, end - start);
+        modes.push_back(DeadlineMode::None);
+        if (!ParseDeadlineMode(name, modes.back())) {
+            fprintf(stderr, "deadlines: unknown mode '%s' (expected none, edf, slack or llf)\n", Narrow(name).c_str());
+            return 1;
+        }
+        start = end + 1;
+    }
+
+    SchedulerOptions options = GetSchedulerOptions(args);
+    int failures = 0;
+    WithEngineFor(workload, options, [&](auto& engine) {
+        for (DeadlineMode mode : modes) {
+            options.deadlineMode = mode;
+            engine.Reset();
+            engine.SetOptions(options);
+            SubmitWorkload(workload, engine);
+            auto start = std::chrono::steady_clock::now();
+            engine.RunToCompletion();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const char* label = mode == DeadlineMode::None ? "srtn" : mode == DeadlineMode::Edf ? "edf" :
+                mode == DeadlineMode::Slack ? "slack" : "llf";
+            const auto& processes = engine.Processes();
+            DeadlineSummary deadlines = SummarizeDeadlines(processes, engine.Arrivals(), engine.Deadlines(),
+                engine.NO_DEADLINE);
+            PrintSummary(label, Summarize(processes, engine.Now()));
+            PrintStats(label, engine.Stats(), engine.Now());
+            PrintDeadlines(label, deadlines);
+            printf("%s: %lld misses seen online, %lld slack overrides, %.3f s\n", label, engine.Stats().deadlineMisses,
+                engine.Stats().slackOverrides, seconds);
+            if (static_cast<size_t>(engine.Stats().deadlineMisses) != deadlines.missed) {
+                printf("%s: online miss count differs from the completed schedule\n", label);
+                failures++;
+            }
+        }
+        PrintEngineWidths("deadlines", engine);
+    });
+    return failures == 0 ? 0 : 1;
+}
+
+// An overloaded trace run without admission control, then under each policy
+// at each ready-set limit. Reports what was taken and turned away, how the
+// accepted jobs fared, and how large the ready set and the engine grew.
+int RunAdmission(const std::vector<std::wstring>& args) {
+    WorkloadOptions workloadOptions = GetWorkloadOptions(args);
+    workloadOptions.load = GetDouble(args, L"--load", 1.2);
+    Workload workload;
+    GenerateWorkload(workloadOptions, workload);
+
+    std::vector<AdmissionPolicy> policies;
+    std::wstring list = GetOption(args, L"--policies", L"reject,defer,shed");
+    for (size_t start = 0; start <= list.size();) {
+        size_t end = std::min(list.find(L',', start), list.size());
+        std::wstring name = list.substr(start, end - start);
+        policies.push_back(AdmissionPolicy::Unbounded);
+        if (!ParseAdmissionPolicy(name, policies.back())) {
+            fprintf(stderr, "admission: unknown policy '%s' (expected unbounded, reject, defer or shed)\n",
+                Narrow(name).c_str());
+            return 1;
+        }
+        start = end + 1;
+    }
+    std::vector<int> limits = GetList(args, L"--max-ready", 64);
+
+    SchedulerOptions options = GetSchedulerOptions(args);
+    WithEngineFor(workload, options, [&](auto& engine) {
+        auto run = [&](const char* label) {
+            engine.Reset();
+            engine.SetOptions(options);
+            SubmitWorkload(workload, engine);
+            auto start = std::chrono::steady_clock::now();
+            engine.RunToCompletion();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const SchedulerStats& stats = engine.Stats();
+            PrintSummary(label, Summarize(engine.Processes(), engine.Now()));
+            printf("%s: admitted %lld (work %lld), deferred %lld, rejected %lld (work %lld), shed %lld (work %lld)\n",
+                label, stats.admitted, stats.admittedWork, stats.deferred, stats.rejected, stats.rejectedWork,
+                stats.shed, stats.shedWork);
+            printf("%s: peak ready %zu, %.1f MB engine memory, %.3f s\n", label, stats.peakReady,
+                engine.MemoryUsage() / (1024.0 * 1024.0), seconds);
+        };
+
+        options.admission = AdmissionPolicy::Unbounded;
+        run("unbounded");
+        for (AdmissionPolicy policy : policies) {
+            if (policy == AdmissionPolicy::Unbounded) {
+                continue;
+            }
+            for (int limit : limits) {
+                options.admission = policy;
+                options.maxReady = limit;
+                const char* name = policy == AdmissionPolicy::Reject ? "reject" :
+                    policy == AdmissionPolicy::Defer ? "defer" : "shed";
+                std::string label = std::string(name) + "/" + std::to_string(limit);
+                run(label.c_str());
+            }
+        }
+        PrintEngineWidths("admission", engine);
+    });
+    return 0;
+}
+
+// Jobs that alternate CPU and I/O, once per device discipline. Reports CPU
+// and device utilization, and how far overlapping I/O with other jobs' CPU
+// time beats running each job's bursts back to back.
+int RunIo(const std::vector<std::wstring>& args) {
+    WorkloadOptions workloadOptions = GetWorkloadOptions(args);
+    GetIoOptions(args, workloadOptions);
+    workloadOptions.devices = std::max(1, workloadOptions.devices);
+    Workload workload;
+    GenerateWorkload(workloadOptions, workload);
+
+    long long serial = 0;
+    for (const auto& process : workload.processes) {
+        serial += process.burstTime;
+    }
+    for (const auto& burst : workload.bursts) {
+        serial += burst.io;
+    }
+
+    std::vector<IoDiscipline> disciplines;
+    std::wstring list = GetOption(args, L"--disciplines", L"fifo,sjf");
+    for (size_t start = 0; start <= list.size();) {
+        size_t end = std::min(list.find(L',', start), list.size());
+        std::wstring name = list.substr(start, end - start);
+        if (name == L"fifo") {
+            disciplines.push_back(IoDiscipline::Fifo);
+        }
+        else if (name == L"sjf") {
+            disciplines.push_back(IoDiscipline::ShortestFirst);
+        }
+        else {
+            fprintf(stderr, "io: unknown discipline '%s' (expected fifo or sjf)\n", Narrow(name).c_str());
+            return 1;
+        }
+        start = end + 1;
+    }
+
+    SchedulerOptions options = GetSchedulerOptions(args);
+    WithEngineFor(workload, options, [&](auto& engine) {
+        for (IoDiscipline discipline : disciplines) {
+            DeviceOptions device;
+            device.discipline = discipline;
+            engine.Reset();
+            engine.SetOptions(options);
+            engine.SetDevices(std::vector<DeviceOptions>(workloadOptions.devices, device));
+            SubmitWorkload(workload, engine);
+            engine.RunToCompletion();
+
+            const char* label = discipline == IoDiscipline::Fifo ? "io fifo" : "io sjf";
+            long long makespan = engine.Now();
+            PrintSummary(label, Summarize(engine.Processes(), makespan));
+            PrintStats(label, engine.Stats(), makespan);
+            PrintDeviceStats(label, engine.Stats(), engine.DeviceStatistics(), makespan);
+            printf("%s: %.4f jobs/unit, makespan %lld vs %lld with no overlap (%.2fx)\n", label,
+                makespan > 0 ? static_cast<double>(workload.processes.size()) / makespan : 0.0,
+                makespan, serial, makespan > 0 ? static_cast<double>(serial) / makespan : 0.0);
+        }
+        PrintEngineWidths("io", engine);
+    });
+    return 0;
+}
+
+// Per tenant: turnaround over the whole run, and the jobs completed and CPU
+// received up to `until`, while every tenant is still submitting
+template <typename Time, typename Segment>
+void PrintGroupReport(const char* label, const std::vector<BasicProcess<Time>>& processes,
+    const std::vector<Segment>& timeline, const std::vector<int>& groups, const std::vector<int>& weights,
+    long long until) {
+    std::vector<long long> cpu(weights.size(), 0);
+    for (const auto& segment : timeline) {
+        size_t index = static_cast<size_t>(segment.processIndex);
+        if (index >= processes.size() || segment.startTime >= until) {
+            continue;
+        }
+        cpu[groups[index]] += std::min<long long>(segment.length, until - segment.startTime);
+    }
+    long long total = 0;
+    for (long long time : cpu) {
+        total += time;
+    }
+
+    std::vector<BasicProcess<Time>> members;
+    for (size_t g = 0; g < weights.size(); g++) {
+        members.clear();
+        long long done = 0;
+        for (size_t i = 0; i < processes.size(); i++) {
+            if (groups[i] != static_cast<int>(g)) {
+                continue;
+            }
+            members.push_back(processes[i]);
+            const auto& p = processes[i];
+            done += p.completed && p.appearingTime + p.turnaroundTime <= until ? 1 : 0;
+        }
+        RunSummary summary = Summarize(members, 0);
+        printf("%s: tenant %zu weight %d: %zu jobs, turnaround mean %.2f p99 %lld max %lld; "
+            "to clock %lld %.4f jobs/unit, %.1f%% of the CPU\n", label, g, weights[g], summary.processes,
+            summary.meanTurnaround, summary.p99Turnaround, summary.maxTurnaround, until,
+            until > 0 ? static_cast<double>(done) / until : 0.0, total > 0 ? 100.0 * cpu[g] / total : 0.0);
+    }
+}
+
+// Tenant 0 floods the CPU with tiny jobs while the others submit ordinary
+// ones. Runs plain SRTN, where the flood takes the CPU, then fair-share
+// groups with SRTN inside each, and reports every tenant's share.
+int RunFairShare(const std::vector<std::wstring>& args) {
+    WorkloadOptions base = GetWorkloadOptions(args);
+    base.load = GetDouble(args, L"--load", 0.4);
+    int tenants = std::max(1, static_cast<int>(GetNumber(args, L"--tenants", 3)));
+    double floodLoad = GetDouble(args, L"--flood-load", 0.6);
+    int floodBurst = std::max(1, static_cast<int>(GetNumber(args, L"--flood-burst", 2)));
+    FairShareOptions fairOptions;
+    fairOptions.quantum = static_cast<int>(GetNumber(args, L"--quantum", fairOptions.quantum));
+
+    // The flood spans the same time as the other tenants' trace
+    Workload workload;
+    WorkloadOptions flood = base;
+    double span = base.load > 0 ? base.count * static_cast<double>(base.meanBurst) / base.load : 0.0;
+    flood.meanBurst = floodBurst;
+    flood.load = floodLoad;
+    flood.count = static_cast<int>(span * floodLoad / floodBurst);
+    AppendTenant(flood, 0, workload);
+    for (int t = 1; t <= tenants; t++) {
+        WorkloadOptions tenant = base;
+        tenant.count = base.count / tenants;
+        tenant.load = base.load / tenants;
+        tenant.seed = base.seed + t;
+        AppendTenant(tenant, t, workload);
+    }
+    if (workload.processes.empty()) {
+        printf("fair-share: no processes\n");
+        return 1;
+    }
+
+    std::vector<int> weights = GetList(args, L"--weights", 1);
+    weights.resize(tenants + 1, weights.back());
+    long long lastArrival = *std::max_element(workload.arrivalTimes.begin(), workload.arrivalTimes.end());
+    printf("fair-share: %zu jobs, %d from the flood tenant, %d others, quantum %d\n", workload.processes.size(),
+        std::max(0, flood.count), tenants, fairOptions.quantum);
+
+    SchedulerOptions options;
+    WithEngineFor(workload, options, [&](auto& engine) {
+        typedef decltype(engine.Now()) Time;
+        typedef decltype(engine.Running()) Index;
+
+        SubmitWorkload(workload, engine);
+        engine.RunToCompletion();
+        PrintSummary("srtn", Summarize(engine.Processes(), engine.Now()));
+        PrintGroupReport("srtn", engine.Processes(), engine.Timeline(), workload.groups, weights, lastArrival);
+
+        BasicFairShareEngine<Time, Index> fair;
+        fair.SetOptions(fairOptions);
+        for (int weight : weights) {
+            fair.AddGroup(weight);
+        }
+        for (size_t i = 0; i < workload.processes.size(); i++) {
+            fair.Submit(ProcessCast<Time>(workload.processes[i]), static_cast<Time>(workload.arrivalTimes[i]),
+                workload.groups[i]);
+        }
+        auto start = std::chrono::steady_clock::now();
+        fair.RunToCompletion();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        PrintSummary("fair-share", Summarize(fair.Processes(), fair.Now()));
+        PrintGroupReport("fair-share", fair.Processes(), fair.Timeline(), workload.groups, weights, lastArrival);
+        printf("fair-share: %lld preemptions within groups, %.3f s\n", fair.Preemptions(), seconds);
+        PrintEngineWidths("fair-share", fair);
+    });
+    return 0;
+}
+
+// Same workload with exact bursts, then ranked by predicted bursts, once
+// per smoothing factor
+int RunPredict(const std::vector<std::wstring>& args) {
+    Workload workload;
+    GenerateWorkload(GetWorkloadOptions(args), workload);
+
+    SchedulerOptions scheduler = GetSchedulerOptions(args);
+    PredictorOptions options;
+    options.initialGuess = static_cast<int>(GetNumber(args, L"--initial-guess", options.initialGuess));
+
+    WithEngineFor(workload, scheduler, [&](auto& engine) {
+        engine.SetOptions(scheduler);
+        SubmitWorkload(workload, engine);
+        engine.RunToCompletion();
+        RunSummary oracle = Summarize(engine.Processes(), engine.Now());
+        PrintSummary("oracle", oracle);
+
+        for (double alpha : GetDoubleList(args, L"--alphas", options.alpha)) {
+            options.alpha = alpha;
+            BurstPredictor predictor(options);
+            engine.Reset();
+            engine.SetPredictor(&predictor);
+            SubmitWorkload(workload, engine);
+            engine.RunToCompletion();
+
+            char label[64];
+            snprintf(label, sizeof(label), "alpha=%.2f", alpha);
+            RunSummary predicted = Summarize(engine.Processes(), engine.Now());
+            PrintSummary(label, predicted);
+
+            PredictionError error = MeasurePredictionError(engine.Processes(), engine.Estimates());
+            printf("%s: prediction error mean %.2f units (%.1f%% of burst), bias %+.2f\n",
+                label, error.meanAbsolute, 100.0 * error.meanRelative, error.bias);
+            printf("%s: turnaround penalty vs oracle mean %+.1f%% p99 %+.1f%%\n", label,
+                oracle.meanTurnaround > 0 ? 100.0 * (predicted.meanTurnaround / oracle.meanTurnaround - 1) : 0.0,
+                oracle.p99Turnaround > 0 ? 100.0 * (static_cast<double>(predicted.p99Turnaround) / oracle.p99Turnaround - 1) : 0.0);
+            engine.SetPredictor(nullptr);
+        }
+        PrintEngineWidths("predict", engine);
+    });
+    return 0;
+}
+
+// Advance in slices of `every` time units, checkpointing after each one, and
+// stop early at stopAt (if positive) to stand in for a crash
+template <typename Engine>
+void RunCheckpointed(Engine& engine, const std::string& path, long long every, long long stopAt) {
+    std::unique_ptr<CheckpointWriter> writer(path.empty() ? nullptr : new CheckpointWriter(path));
+    std::vector<unsigned char> snapshot;
+    double captureSeconds = 0;
+    long long captures = 0;
+    size_t largest = 0;
+    every = std::max(1LL, every);
+
+    while (engine.HasWork() && (stopAt <= 0 || engine.Now() < stopAt)) {
+        long long until = std::min<long long>(static_cast<long long>(engine.Now()) + every, Engine::MAX_TIME - 1);
+        if (stopAt > 0) {
+            until = std::min(until, stopAt);
+        }
+        engine.RunUntil(static_cast<decltype(engine.Now())>(until));
+        if (writer) {
+            auto start = std::chrono::steady_clock::now();
+            engine.SaveState(snapshot);
+            captureSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            captures++;
+            largest = std::max(largest, snapshot.size());
+            writer->Write(snapshot);
+        }
+    }
+
+    if (writer) {
+        writer->Flush();
+        printf("checkpoint: %lld captures, %.1f us each, up to %zu bytes, %lld written to %s%s\n", captures,
+            captures > 0 ? 1e6 * captureSeconds / captures : 0.0, largest, writer->Written(), path.c_str(),
+            writer->Failed() ? " (some writes failed)" : "");
+    }
+    if (engine.HasWork()) {
+        printf("checkpoint: stopped at clock %lld with %zu/%zu completed\n",
+            static_cast<long long>(engine.Now()), engine.CompletedCount(), engine.ProcessCount());
+        return;
+    }
+    // The clock stops at the end of the last slice; the run ended with its
+    // last completion, as in --simulate
+    long long makespan = 0;
+    const auto& processes = engine.Processes();
+    for (size_t i = 0; i < processes.size(); i++) {
+        makespan = std::max<long long>(makespan, static_cast<long long>(engine.Arrivals()[i]) + processes[i].turnaroundTime);
+    }
+    PrintSummary("run", Summarize(processes, makespan));
+    PrintStats("run", engine.Stats(), makespan);
+    printf("run: digest %016llx\n", static_cast<unsigned long long>(RunDigest(engine)));
+}
+
+// A synthetic workload run in slices with a checkpoint after each one
+int RunCheckpointRun(const std::vector<std::wstring>& args) {
+    Workload workload;
+    WorkloadOptions workloadOptions = GetWorkloadOptions(args);
+    GetIoOptions(args, workloadOptions);
+    if (workloadOptions.devices > 0 && GetOption(args, L"--trace", L"").empty()) {
+        GenerateWorkload(workloadOptions, workload);
+    }
+    else if (!GetWorkload(args, workload)) {
+        return 1;
+    }
+    SchedulerOptions options = GetSchedulerOptions(args);
+    std::string path = Narrow(GetOption(args, L"--checkpoint", L""));
+    long long every = static_cast<long long>(GetNumber(args, L"--every", 10000));
+    long long stopAt = static_cast<long long>(GetNumber(args, L"--stop-at", 0));
+
+    // Jobs with I/O need their devices; the checkpoint carries them from here on
+    int devices = workload.firstBurst.empty() ? 0 : workloadOptions.devices;
+    WithEngineFor(workload, options, [&](auto& engine) {
+        engine.SetOptions(options);
+        engine.SetDevices(std::vector<DeviceOptions>(devices));
+        SubmitWorkload(workload, engine);
+        RunCheckpointed(engine, path, every, stopAt);
+    });
+    return 0;
+}
+
+// Continue a checkpoint to completion, still checkpointing to the same file
+int RunResume(const std::vector<std::wstring>& args) {
+    std::string path = Narrow(GetOption(args, L"--resume", L""));
+    std::vector<unsigned char> bytes;
+    if (path.empty() || !ReadWholeFile(path, bytes)) {
+        printf("resume: cannot read checkpoint '%s'\n", path.c_str());
+        return 1;
+    }
+    ByteReader header(bytes.data(), bytes.size());
+    size_t timeBytes = 0;
+    size_t indexBytes = 0;
+    std::string error;
+    if (!ReadCheckpointHeader(header, timeBytes, indexBytes, error)) {
+        printf("resume: %s\n", error.c_str());
+        return 1;
+    }
+    EngineWidths widths;
+    widths.wideTime = timeBytes > 4;
+    widths.wideIndex = indexBytes > 2;
+
+    bool loaded = false;
+    long long every = static_cast<long long>(GetNumber(args, L"--every", 10000));
+    WithEngineWidths(widths, [&](auto& engine) {
+        if (!engine.LoadState(bytes, error)) {
+            return;
+        }
+        loaded = true;
+        printf("resume: clock %lld, %zu/%zu completed\n",
+            static_cast<long long>(engine.Now()), engine.CompletedCount(), engine.ProcessCount());
+        RunCheckpointed(engine, path, every, 0);
+    });
+    if (!loaded) {
+        printf("resume: %s\n", error.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+// Run once, index the timeline, and answer --at, --slices and --range
+// queries from the index. Random queries of each kind are timed against a
+// linear scan of the timeline and must give the same answers.
+int RunTimeline(const std::vector<std::wstring>& args) {
+    Workload workload;
+    if (!GetWorkload(args, workload)) {
+        return 1;
+    }
+    SchedulerOptions options = GetSchedulerOptions(args);
+    int queries = static_cast<int>(GetNumber(args, L"--queries", 1000));
+    int failures = 0;
+    WithEngineFor(workload, options, [&](auto& engine) {
+        typedef decltype(engine.Now()) Time;
+        typedef decltype(engine.Running()) Index;
+        typedef BasicRunSegment<Time, Index> Segment;
+        engine.SetOptions(options);
+        SubmitWorkload(workload, engine);
+
+        // With --every the index grows alongside the run, one slice at a time
+        BasicTimelineIndex<Time, Index> index;
+        double buildSeconds = 0;
+        long long every = static_cast<long long>(GetNumber(args, L"--every", 0));
+        bool working = true;
+        while (working) {
+            if (every > 0) {
+                working = engine.RunUntil(static_cast<Time>(std::min<long long>(
+                    static_cast<long long>(engine.Now()) + every, engine.MAX_TIME - 1)));
+            }
+            else {
+                engine.RunToCompletion();
+                working = false;
+            }
+            auto start = std::chrono::steady_clock::now();
+            index.Update(engine.Timeline());
+            buildSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        const auto& timeline = engine.Timeline();
+        printf("timeline: %zu segments, end %lld, index built in %.3f s, %.1f MB\n", index.Size(),
+            static_cast<long long>(index.End()), buildSeconds, index.MemoryUsage() / (1024.0 * 1024.0));
+
+        auto print = [&index](const char* label, const Segment& segment) {
+            if (segment.processIndex == index.NO_PROCESS) {
+                printf("  %s switch [%lld, %lld)\n", label, static_cast<long long>(segment.startTime),
+                    static_cast<long long>(segment.startTime + segment.length));
+            }
+            else {
+                printf("  %s process %lld [%lld, %lld)\n", label, static_cast<long long>(segment.processIndex),
+                    static_cast<long long>(segment.startTime), static_cast<long long>(segment.startTime + segment.length));
+            }
+        };
+        std::vector<Segment> found;
+        if (!GetOption(args, L"--at", L"").empty()) {
+            for (int t : GetList(args, L"--at", 0)) {
+                size_t position = index.At(static_cast<Time>(t));
+                if (position == index.NONE) {
+                    printf("  at %d: idle\n", t);
+                }
+                else {
+                    print(("at " + std::to_string(t) + ":").c_str(), index.SegmentAt(position));
+                }
+            }
+        }
+        if (!GetOption(args, L"--slices", L"").empty()) {
+            for (int process : GetList(args, L"--slices", 0)) {
+                found.clear();
+                index.SlicesOf(static_cast<Index>(process), found);
+                printf("  process %d: %zu slices\n", process, found.size());
+                for (const auto& segment : found) {
+                    print("slice", segment);
+                }
+            }
+        }
+        std::vector<int> range = GetList(args, L"--range", 0);
+        if (range.size() >= 2) {
+            found.clear();
+            index.Overlapping(static_cast<Time>(range[0]), static_cast<Time>(range[1]), found);
+            printf("  [%d, %d): %zu segments\n", range[0], range[1], found.size());
+            for (const auto& segment : found) {
+                print("ran", segment);
+            }
+        }
+
+        // Random queries of each kind against a scan of the whole timeline
+        if (timeline.empty() || queries <= 0) {
+            return;
+        }
+        uint64_t state = 1;
+        long long end = static_cast<long long>(index.End());
+        double indexSeconds[3] = {};
+        double scanSeconds[3] = {};
+        std::vector<Segment> expected;
+        for (int q = 0; q < queries; q++) {
+            Time t = static_cast<Time>(SplitMix64(state) % end);
+            Time width = static_cast<Time>(SplitMix64(state) % 64 + 1);
+            Index process = static_cast<Index>(SplitMix64(state) % workload.processes.size());
+
+            // What ran at t
+            auto begin = std::chrono::steady_clock::now();
+            size_t position = index.At(t);
+            auto mid = std::chrono::steady_clock::now();
+            size_t scanned = index.NONE;
+            for (size_t i = 0; i < timeline.size(); i++) {
+                if (timeline[i].startTime <= t && t < timeline[i].startTime + timeline[i].length) {
+                    scanned = i;
+                    break;
+                }
+            }
+            indexSeconds[0] += std::chrono::duration<double>(mid - begin).count();
+            scanSeconds[0] += std::chrono::duration<double>(std::chrono::steady_clock::now() - mid).count();
+            failures += position != scanned ? 1 : 0;
+
+            // Every slice of one process
+            found.clear();
+            expected.clear();
+            begin = std::chrono::steady_clock::now();
+            index.SlicesOf(process, found);
+            mid = std::chrono::steady_clock::now();
+            for (const auto& segment : timeline) {
+                if (segment.processIndex == process) {
+                    expected.push_back(segment);
+                }
+            }
+            indexSeconds[1] += std::chrono::duration<double>(mid - begin).count();
+            scanSeconds[1] += std::chrono::duration<double>(std::chrono::steady_clock::now() - mid).count();
+            failures += found.size() != expected.size() ||
+                !std::equal(found.begin(), found.end(), expected.begin(), [](const Segment& a, const Segment& b) {
+                    return a.startTime == b.startTime && a.length == b.length;
+                }) ? 1 : 0;
+
+            // Who ran in [t, t + width)
+            found.clear();
+            expected.clear();
+            begin = std::chrono::steady_clock::now();
+            index.Overlapping(t, t + width, found);
+            mid = std::chrono::steady_clock::now();
+            for (const auto& segment : timeline) {
+                if (segment.startTime < t + width && t < segment.startTime + segment.length) {
+                    expected.push_back(segment);
+                }
+            }
+            indexSeconds[2] += std::chrono::duration<double>(mid - begin).count();
+            scanSeconds[2] += std::chrono::duration<double>(std::chrono::steady_clock::now() - mid).count();
+            failures += found.size() != expected.size() ||
+                !std::equal(found.begin(), found.end(), expected.begin(), [](const Segment& a, const Segment& b) {
+                    return a.startTime == b.startTime && a.length == b.length;
+                }) ? 1 : 0;
+        }
+        const char* kinds[3] = { "at", "slices", "range" };
+        for (int k = 0; k < 3; k++) {
+            printf("timeline: %d %s queries, index %.2f us each, scan %.2f us each\n", queries, kinds[k],
+                indexSeconds[k] * 1e6 / queries, scanSeconds[k] * 1e6 / queries);
+        }
+        if (failures > 0) {
+            printf("timeline: %d queries disagree with the scan\n", failures);
+        }
+    });
+    return failures == 0 ? 0 : 1;
+}
+
+// FNV-1a over segments as a timeline file stores them, so a saved run and
+// its replay can be compared whatever the engine's widths
+void MixRecord(uint64_t& hash, const TimelineRecord& record) {
+    for (long long value : { record.processIndex, record.startTime, record.length }) {
+        for (int i = 0; i < 8; i++) {
+            hash = (hash ^ static_cast<unsigned char>(value >> (8 * i))) * 1099511628211ULL;
+        }
+    }
+}
+
+// Run a workload straight into a timeline file, one generator slice at a time
+int RunSaveTimeline(const std::vector<std::wstring>& args) {
+    std::string path = Narrow(GetOption(args, L"--save-timeline", L""));
+    if (path.empty()) {
+        fprintf(stderr, "save-timeline: expected a file name\n");
+        return 1;
+    }
+    Workload workload;
+    if (!GetWorkload(args, workload)) {
+        return 1;
+    }
+    SchedulerOptions options = GetSchedulerOptions(args);
+    long long every = static_cast<long long>(GetNumber(args, L"--every", 4096));
+    TimelineWriter writer;
+    std::string error;
+    if (!writer.Open(path, error)) {
+        fprintf(stderr, "save-timeline: %s\n", error.c_str());
+        return 1;
+    }
+
+    uint64_t digest = 14695981039346656037ULL;
+    size_t segmentBytes = 0;
+    size_t peak = 0;
+    long long end = 0;
+    auto start = std::chrono::steady_clock::now();
+    WithEngineFor(workload, options, [&](auto& engine) {
+        typedef decltype(engine.Now()) Time;
+        typedef decltype(engine.Running()) Index;
+        engine.SetOptions(options);
+        SubmitWorkload(workload, engine);
+        segmentBytes = sizeof(BasicRunSegment<Time, Index>);
+
+        // The run goes to disk as it is generated, and the engine holds only
+        // what one slice produced
+        BasicScheduleGenerator<Time, Index> generator(engine, static_cast<Time>(std::min<long long>(every, INT_MAX)));
+        for (const auto& event : generator) {
+            if (event.kind == ScheduleEventKind::Segment) {
+                TimelineRecord record = ToRecord(event.segment);
+                writer.Append(record);
+                MixRecord(digest, record);
+                end = record.startTime + record.length;
+            }
+        }
+        peak = generator.MaxHeld();
+        PrintEngineWidths("save-timeline", engine);
+    });
+    uint64_t segments = writer.SegmentCount();
+    if (!writer.Close(error)) {
+        fprintf(stderr, "save-timeline: %s\n", error.c_str());
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t bytes = writer.BytesWritten();
+    printf("save-timeline: %llu segments to %s, end %lld, in %.3f s, digest %016llx\n",
+        static_cast<unsigned long long>(segments), path.c_str(), end, seconds, static_cast<unsigned long long>(digest));
+    printf("save-timeline: %.1f MB on disk, %.2f bytes/segment; in memory %.1f MB as segments, "
+        "%.1f MB as one ExecutionStep per time unit; at most %zu segments and completions held\n",
+        bytes / (1024.0 * 1024.0), segments > 0 ? static_cast<double>(bytes) / segments : 0.0,
+        static_cast<double>(segments) * segmentBytes / (1024.0 * 1024.0),
+        static_cast<double>(end) * sizeof(ExecutionStep) / (1024.0 * 1024.0), peak);
+    return 0;
+}
+
+// Stream a saved timeline file to stdout as SEG lines, optionally paced
+int RunReplay(const std::vector<std::wstring>& args) {
+    std::string path = Narrow(GetOption(args, L"--replay", L""));
+    double speed = GetDouble(args, L"--speed", 0);
+    long long from = static_cast<long long>(GetNumber(args, L"--from", 0));
+    long long to = static_cast<long long>(GetNumber(args, L"--to", static_cast<unsigned long long>(LLONG_MAX)));
+    bool quiet = std::find(args.begin(), args.end(), L"--quiet") != args.end();
+    TimelineReader reader;
+    std::string error;
+    if (!reader.Open(path, error) || !reader.Seek(from, error)) {
+        fprintf(stderr, "replay: %s\n", error.c_str());
+        return 1;
+    }
+
+    // Paced, time unit `from` is due at once and the rest follow at `speed`
+    // units per second; each segment is printed and flushed when it starts
+    std::unique_ptr<TickPacer> pacer;
+    if (speed > 0) {
+        pacer.reset(new TickPacer(std::chrono::nanoseconds(static_cast<long long>(1e9 / speed))));
+        pacer->Start(from);
+    }
+    uint64_t digest = 14695981039346656037ULL;
+    uint64_t count = 0;
+    auto start = std::chrono::steady_clock::now();
+    TimelineRecord record;
+    while (reader.Next(record, error) && record.startTime < to) {
+        if (pacer) {
+            while (pacer->DueTick() < record.startTime) {
+                std::this_thread::sleep_for(pacer->UntilNextTick());
+            }
+            pacer->Reached(record.startTime);
+        }
+        if (!quiet) {
+            printf("SEG %lld %lld %lld\n", record.processIndex, record.startTime, record.length);
+            if (pacer) {
+                fflush(stdout);
+            }
+        }
+        MixRecord(digest, record);
+        count++;
+    }
+    if (!error.empty()) {
+        fprintf(stderr, "replay: %s\n", error.c_str());
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // The segments go to stdout for a viewer, so the summary does not
+    fprintf(stderr, "replay: %llu of %llu segments in %zu blocks, end %lld, in %.3f s (%.1f M segments/s), digest %016llx\n",
+        static_cast<unsigned long long>(count), static_cast<unsigned long long>(reader.SegmentCount()),
+        reader.BlockCount(), reader.End(), seconds, seconds > 0 ? count / seconds / 1e6 : 0.0,
+        static_cast<unsigned long long>(digest));
+    return 0;
+}
+
+// Pull a run lazily from the schedule generator: all of it, one page, or up to the first preemption
+int RunStream(const std::vector<std::wstring>& args) {
+    Workload workload;
+    if (!GetWorkload(args, workload)) {
+        return 1;
+    }
+    SchedulerOptions options = GetSchedulerOptions(args);
+    long long step = static_cast<long long>(GetNumber(args, L"--step", 4096));
+    std::wstring page = GetOption(args, L"--page", L"");
+    size_t pageSize = static_cast<size_t>(GetNumber(args, L"--page-size", 20));
+    bool firstPreemption = std::find(args.begin(), args.end(), L"--first-preemption") != args.end();
+    auto start = std::chrono::steady_clock::now();
+    WithEngineFor(workload, options, [&](auto& engine) {
+        typedef decltype(engine.Now()) Time;
+        typedef decltype(engine.Running()) Index;
+        typedef BasicScheduleEvent<Time, Index> Event;
+        engine.SetOptions(options);
+        SubmitWorkload(workload, engine);
+        BasicScheduleGenerator<Time, Index> generator(engine, static_cast<Time>(std::min<long long>(step, INT_MAX)));
+
+        auto print = [&engine](const Event& event) {
+            const auto& segment = event.segment;
+            if (event.kind == ScheduleEventKind::Completion) {
+                printf("  process %lld done at %lld\n", static_cast<long long>(segment.processIndex),
+                    static_cast<long long>(segment.startTime));
+            }
+            else if (segment.processIndex == engine.NO_PROCESS) {
+                printf("  switch [%lld, %lld)\n", static_cast<long long>(segment.startTime),
+                    static_cast<long long>(segment.startTime + segment.length));
+            }
+            else {
+                printf("  process %lld [%lld, %lld)\n", static_cast<long long>(segment.processIndex),
+                    static_cast<long long>(segment.startTime), static_cast<long long>(segment.startTime + segment.length));
+            }
+        };
+
+        // Each consumer pulls only as far as it needs, and the engine runs
+        // no further than that
+        uint64_t segments = 0;
+        uint64_t completions = 0;
+        uint64_t digest = 14695981039346656037ULL;
+        if (!page.empty()) {
+            size_t first = static_cast<size_t>(GetNumber(args, L"--page", 0)) * pageSize;
+            Event event;
+            for (size_t skipped = 0; skipped < first && generator.Next(event); skipped++) {
+            }
+            std::vector<Event> events;
+            generator.Take(pageSize, events);
+            printf("stream: page %ls, events %zu to %zu\n", page.c_str(), first, first + events.size());
+            for (const auto& event : events) {
+                print(event);
+            }
+        }
+        else if (firstPreemption) {
+            // A process segment followed by anything but that process's
+            // completion left the CPU unfinished
+            Event last = {};
+            bool running = false;
+            bool found = false;
+            for (const auto& event : generator) {
+                bool ends = event.kind == ScheduleEventKind::Completion &&
+                    event.segment.processIndex == last.segment.processIndex;
+                if (running && !ends) {
+                    found = true;
+                    break;
+                }
+                running = event.kind == ScheduleEventKind::Segment && event.segment.processIndex != engine.NO_PROCESS;
+                if (running) {
+                    last = event;
+                }
+            }
+            if (found) {
+                printf("stream: first preemption:\n");
+                print(last);
+            }
+            else {
+                printf("stream: no process was preempted\n");
+            }
+        }
+        else {
+            for (const auto& event : generator) {
+                if (event.kind == ScheduleEventKind::Segment) {
+                    MixRecord(digest, ToRecord(event.segment));
+                    segments++;
+                }
+                else {
+                    completions++;
+                }
+            }
+            printf("stream: %llu segments and %llu completions, digest %016llx\n",
+                static_cast<unsigned long long>(segments), static_cast<unsigned long long>(completions),
+                static_cast<unsigned long long>(digest));
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("stream: engine clock %lld, %zu of %zu processes completed, at most %zu segments and completions held, "
+            "%.1f MB engine, %.3f s\n", static_cast<long long>(engine.Now()), engine.CompletedCount(),
+            engine.ProcessCount(), generator.MaxHeld(), engine.MemoryUsage() / (1024.0 * 1024.0), seconds);
+    });
+    return 0;
+}
+
+// Baseline run once, then "what if this job were faster or came later"
+// for random jobs, each re-simulated only from where it could first matter.
+// --check runs every query again from scratch and compares.
+int RunWhatIf(const std::vector<std::wstring>& args) {
+    WorkloadOptions workloadOptions = GetWorkloadOptions(args);
+    Workload workload;
+    GenerateWorkload(workloadOptions, workload);
+    SchedulerOptions options = GetSchedulerOptions(args);
+    int queries = static_cast<int>(GetNumber(args, L"--queries", 10));
+    double scale = GetDouble(args, L"--burst-scale", 0.8);
+    long long shift = static_cast<long long>(GetNumber(args, L"--arrival-shift", 0));
+    bool check = std::find(args.begin(), args.end(), L"--check") != args.end();
+    if (workload.processes.empty()) {
+        printf("what-if: no processes\n");
+        return 1;
+    }
+    if (options.admission != AdmissionPolicy::Unbounded) {
+        fprintf(stderr, "what-if: admission policies are not supported; a mark does not hold deferred or shed processes\n");
+        return 1;
+    }
+    long long every = static_cast<long long>(GetNumber(args, L"--every",
+        std::max<long long>(1, workload.arrivalTimes.back() / 4096)));
+
+    int mismatches = 0;
+    WithEngineFor(workload, options, [&](auto& engine) {
+        typedef typename std::decay<decltype(engine)>::type Engine;
+        typedef decltype(engine.Now()) Time;
+        typedef decltype(engine.Running()) Index;
+
+        engine.SetOptions(options);
+        SubmitWorkload(workload, engine);
+        BasicWhatIf<Time, Index> whatIf(engine);
+        auto start = std::chrono::steady_clock::now();
+        whatIf.RunBaseline(static_cast<Time>(every));
+        double baseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const WhatIfResult& base = whatIf.Baseline();
+        printf("baseline: %zu processes, makespan %lld, turnaround mean %.2f, %.3f s\n", workload.processes.size(),
+            base.makespan, base.meanTurnaround, baseSeconds);
+        printf("baseline: %zu marks every %lld units, %.1f MB (%.1f bytes/process); %.1f MB kept for queries in all\n",
+            whatIf.MarkCount(), every, whatIf.MarkMemory() / 1048576.0,
+            static_cast<double>(whatIf.MarkMemory()) / workload.processes.size(), whatIf.MemoryUsage() / 1048576.0);
+
+        uint64_t state = workloadOptions.seed ^ 0x5DEECE66DULL;
+        double querySeconds = 0;
+        std::unique_ptr<Engine> fresh(check ? new Engine() : nullptr);
+        Workload changed = check ? workload : Workload();
+        std::vector<typename Engine::Segment> stitched;
+        std::vector<Time> turnarounds;
+        for (int q = 0; q < queries; q++) {
+            Index index = static_cast<Index>(SplitMix64(state) % workload.processes.size());
+            const auto& original = workload.processes[index];
+            Time burst = static_cast<Time>(std::max<long long>(1, std::llround(original.burstTime * scale)));
+            Time arrival = static_cast<Time>(std::max<long long>(0, workload.arrivalTimes[index] + shift));
+
+            start = std::chrono::steady_clock::now();
+            WhatIfResult result = whatIf.Query(index, burst, arrival);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            querySeconds += seconds;
+
+            char rejoined[32] = "the end";
+            if (result.rejoinedAt >= 0) {
+                snprintf(rejoined, sizeof(rejoined), "clock %lld", result.rejoinedAt);
+            }
+            printf("what-if job %lld: burst %lld -> %lld, arrival %lld -> %lld: turnaround %lld, mean %.2f (%+.4f), "
+                "makespan %lld; re-simulated %zu processes from clock %lld to %s in %.3f ms\n",
+                static_cast<long long>(index), static_cast<long long>(original.burstTime),
+                static_cast<long long>(burst), static_cast<long long>(workload.arrivalTimes[index]),
+                static_cast<long long>(arrival), result.turnaround, result.meanTurnaround,
+                result.meanTurnaround - base.meanTurnaround, result.makespan, result.resimulated, result.rewoundTo,
+                rejoined, 1e3 * seconds);
+
+            if (fresh) {
+                // The baseline's workload, deadlines included, with the one job changed
+                changed.processes[index].burstTime = changed.processes[index].remainingTime = burst;
+                changed.arrivalTimes[index] = arrival;
+                fresh->Reset();
+                fresh->SetOptions(options);
+                SubmitWorkload(changed, *fresh);
+                fresh->RunToCompletion();
+                changed.processes[index] = original;
+                changed.arrivalTimes[index] = workload.arrivalTimes[index];
+                whatIf.QueryTimeline(stitched);
+                whatIf.QueryTurnarounds(turnarounds);
+                const auto& timeline = fresh->Timeline();
+                bool same = stitched.size() == timeline.size() && fresh->Now() == result.makespan &&
+                    fresh->Stats().switches == result.stats.switches && fresh->Stats().busyTime == result.stats.busyTime &&
+                    fresh->Stats().deadlineMisses == result.stats.deadlineMisses &&
+                    fresh->Stats().slackOverrides == result.stats.slackOverrides;
+                for (size_t i = 0; same && i < timeline.size(); i++) {
+                    same = stitched[i].processIndex == timeline[i].processIndex &&
+                        stitched[i].startTime == timeline[i].startTime && stitched[i].length == timeline[i].length;
+                }
+                const auto& processes = fresh->Processes();
+                for (size_t i = 0; same && i < processes.size(); i++) {
+                    same = processes[i].turnaroundTime == turnarounds[i];
+                }
+                if (!same) {
+                    mismatches++;
+                    printf("what-if job %lld: differs from a full re-run\n", static_cast<long long>(index));
+                }
+            }
+        }
+        if (queries > 0) {
+            printf("what-if: %d queries, %.3f ms each, %.2f%% of the baseline run\n", queries,
+                1e3 * querySeconds / queries, baseSeconds > 0 ? 100.0 * querySeconds / queries / baseSeconds : 0.0);
+        }
+        if (check) {
+            printf("what-if: %d of %d queries match a full re-run\n", queries - mismatches, queries);
+        }
+        PrintEngineWidths("what-if", engine);
+    });
+    return mismatches == 0 ? 0 : 1;
+}
+
+// The GUI's engine lifecycle from a script: a paced run is paused, stepped,
+// advanced to a time, resumed, stopped and restarted at once, then run out.
+// Reports how long each command took to take effect, and checks the result
+// against an uninterrupted engine run.
+int RunRunnerMode(const std::vector<std::wstring>& args) {
+    Workload workload;
+    GenerateWorkload(GetWorkloadOptions(args), workload);
+    double rate = GetDouble(args, L"--rate", 100000.0);
+    std::vector<Process> processes;
+    for (const auto& process : workload.processes) {
+        processes.push_back(ProcessCast<int>(process));
+    }
+
+    SrtnEngine direct;
+    for (const auto& process : processes) {
+        direct.Submit(process, 0);
+    }
+    direct.RunToCompletion();
+
+    typedef std::chrono::steady_clock Clock;
+    auto micros = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    };
+    auto settle = []() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); };
+
+    EngineRunner runner(std::chrono::nanoseconds(static_cast<long long>(1e9 / std::max(rate, 1.0))));
+    std::atomic<long long> events(0);
+    runner.SetListener([&events](EngineRunner::Event) { events++; });
+    int failures = 0;
+    auto check = [&failures](bool passed, const char* what) {
+        if (!passed) {
+            printf("runner: FAILED: %s\n", what);
+            failures++;
+        }
+    };
+
+    runner.Start(processes);
+    settle();
+    auto start = Clock::now();
+    runner.Pause();
+    double pause = micros(start);
+    long long paused = runner.Now();
+    settle();
+    printf("runner: paused at clock %lld in %.1f us, still %lld after 20 ms\n", paused, pause, runner.Now());
+    check(paused > 0, "the paced run had started before the pause");
+    check(runner.Now() == paused, "the clock holds while paused");
+
+    for (int i = 0; i < 5; i++) {
+        runner.Step();
+    }
+    check(runner.Now() == paused + 5, "5 steps advance the clock by 5");
+    long long target = paused + std::max<long long>(1, (direct.Now() - paused) / 2);
+    start = Clock::now();
+    runner.RunUntil(target);
+    printf("runner: 5 steps to clock %lld, then run-until %lld in %.1f us\n", paused + 5, runner.Now(), micros(start));
+    check(runner.Now() == target, "run-until stops at its target");
+
+    runner.Resume();
+    settle();
+    start = Clock::now();
+    runner.Stop();
+    double stop = micros(start);
+    long long stopped = runner.Now();
+    settle();
+    printf("runner: stopped at clock %lld in %.1f us\n", stopped, stop);
+    check(runner.Now() == stopped, "the clock holds once stopped");
+    // At a fast rate the resumed run may finish before the stop arrives
+    EngineRunner::State state = runner.GetState();
+    check(state == EngineRunner::State::Stopped || state == EngineRunner::State::Finished,
+        "stop leaves the run stopped, unless it had already finished");
+
+    // Restart straight away: there is only ever the one worker
+    runner.Start(processes);
+    start = Clock::now();
+    runner.RunUntil(LLONG_MAX);
+    printf("runner: restarted and ran out to clock %lld in %.1f ms\n", runner.Now(), micros(start) / 1000);
+    check(runner.GetState() == EngineRunner::State::Finished, "the restarted run finishes");
+
+    std::vector<Process> finalProcesses;
+    std::vector<RunSegment> timeline;
+    runner.Snapshot(finalProcesses, timeline);
+    bool same = RunDigest(timeline, finalProcesses) == RunDigest(direct);
+    printf("runner: %lld listener events, result %s the uninterrupted run\n", events.load(),
+        same ? "matches" : "DIFFERS from");
+    check(same, "the restarted run matches the uninterrupted run");
+    return failures == 0 ? 0 : 1;
+}
+
+// Producers post jobs into a live engine while it keeps scheduling
+int RunSubmitBenchmark(const std::vector<std::wstring>& args) {
+    int producers = static_cast<int>(GetNumber(args, L"--producers", 4));
+    long long jobs = static_cast<long long>(GetNumber(args, L"--jobs", 1000000));
+
+    SrtnEngine engine;
+    std::atomic<int> running(producers);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            Process process = { EMPTY_NAME, 0, 0, 0, 0, 0, false };
+            for (long long i = p; i < jobs; i += producers) {
+                process.burstTime = 1 + static_cast<int>(i % 7);
+                process.remainingTime = process.burstTime;
+                engine.Post(process);
+            }
+            running--;
+        });
+    }
+
+    // The engine drains at every decision point, one time unit at a time
+    while (running > 0 || engine.HasWork()) {
+        engine.RunUntil(engine.Now() + 1);
+    }
+    double submitted = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    printf("bench-submit: %d producers, %lld jobs scheduled in %.2f s (%.0f jobs/s), clock %d\n",
+        producers, jobs, submitted, submitted > 0 ? jobs / submitted : 0.0, engine.Now());
+    return engine.Processes().size() == static_cast<size_t>(jobs) ? 0 : 1;
+}
+
+// Real-time run at a scaled speed: does the engine keep up with the wall clock?
+int RunPaced(const std::vector<std::wstring>& args) {
+    double rate = GetDouble(args, L"--rate", 1000.0);
+    double seconds = GetDouble(args, L"--seconds", 5.0);
+    if (rate <= 0) {
+        printf("paced: --rate must be positive\n");
+        return 1;
+    }
+
+    Workload workload;
+    GenerateWorkload(GetWorkloadOptions(args), workload);
+    SchedulerOptions options = GetSchedulerOptions(args);
+
+    TickPacer pacer(std::chrono::nanoseconds(static_cast<long long>(1e9 / rate)));
+    auto start = TickPacer::Clock::now();
+    long long clock = 0;
+    WithEngineFor(workload, options, [&](auto& engine) {
+        engine.SetOptions(options);
+        SubmitWorkload(workload, engine);
+
+        pacer.Start();
+        start = TickPacer::Clock::now();
+        auto end = start + std::chrono::duration_cast<TickPacer::Clock::duration>(std::chrono::duration<double>(seconds));
+        while (TickPacer::Clock::now() < end && engine.RunPaced(pacer)) {
+            std::this_thread::sleep_for(std::min(pacer.UntilNextTick(), std::chrono::nanoseconds(1000000)));
+        }
+        clock = engine.Now();
+    });
+
+    const PacerStats& stats = pacer.Stats();
+    double elapsed = std::chrono::duration<double>(TickPacer::Clock::now() - start).count();
+    printf("paced: clock %lld after %.2f s, %.0f units expected at %.0f units/s\n", clock, elapsed, elapsed * rate, rate);
+    printf("paced: %lld ticks reached, %lld caught up in bulk, lateness mean %.0f us p99 <= %lld us max %lld us\n",
+        stats.ticks, stats.caughtUp, stats.ticks > 0 ? static_cast<double>(stats.totalLatenessMicros) / stats.ticks : 0.0,
+        pacer.LatenessPercentile(99), stats.maxLatenessMicros);
+    return 0;
+}
+
+// Each argmin kernel over arrays of several sizes, then the scan engine
+// against the heap engine on dense ready sets of the same sizes
+int RunSelectBenchmark(const std::vector<std::wstring>& args) {
+    long long budget = static_cast<long long>(GetNumber(args, L"--elements", 200000000));
+    const auto& kernels = SelectKernels();
+
+    // Small value range so ties are common; about a fifth masked out
+    uint64_t state = GetNumber(args, L"--seed", 1);
+    for (size_t size : { 16, 64, 256, 1024, 16384 }) {
+        std::vector<int> values(size);
+        for (auto& value : values) {
+            uint64_t r = SplitMix64(state);
+            value = r % 5 == 0 ? INT_MAX : static_cast<int>(r % 64);
+        }
+        for (int check = 0; check < 64; check++) {
+            values[SplitMix64(state) % size] = static_cast<int>(SplitMix64(state) % 64);
+            for (const auto& kernel : kernels) {
+                if (kernel.argmin(values.data(), size) != ArgminScalar(values.data(), size)) {
+                    printf("bench-select: kernel %s disagrees with scalar at size %zu\n", kernel.name, size);
+                    return 1;
+                }
+            }
+        }
+
+        long long rounds = std::max<long long>(1, budget / static_cast<long long>(size));
+        for (const auto& kernel : kernels) {
+            auto start = std::chrono::steady_clock::now();
+            long long sink = 0;
+            for (long long r = 0; r < rounds; r++) {
+                // Perturb one entry so the call cannot be hoisted
+                values[r % size] ^= 1;
+                sink += kernel.argmin(values.data(), size);
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            printf("argmin %-7s n=%-6zu %8.1f ns/call %6.2f elements/ns (%lld)\n", kernel.name, size,
+                1e9 * seconds / rounds, rounds * static_cast<double>(size) / (1e9 * seconds), sink % 7);
+        }
+    }
+
+    // Dense ready sets: n processes, one arrival per time unit and bursts far
+    // longer than the gap, so every decision sees up to n ready processes
+    long long decisionBudget = static_cast<long long>(GetNumber(args, L"--decisions", 4000000));
+    SrtnEngine heap;
+    ScanEngine scan;
+    Process process = { EMPTY_NAME, 0, 0, 0, 0, 0, false };
+    for (int size : { 8, 32, 128, 512, 2048 }) {
+        std::vector<int> bursts(size);
+        for (auto& burst : bursts) {
+            burst = 1 + static_cast<int>(SplitMix64(state) % (4 * static_cast<uint64_t>(size)));
+        }
+        long long rounds = std::max<long long>(1, decisionBudget / (2 * size));
+        bool same = true;
+
+        auto start = std::chrono::steady_clock::now();
+        for (long long r = 0; r < rounds; r++) {
+            heap.Reset();
+            for (int i = 0; i < size; i++) {
+                process.burstTime = process.remainingTime = bursts[i];
+                heap.Submit(process, i);
+            }
+            heap.RunToCompletion();
+        }
+        double heapSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (long long r = 0; r < rounds; r++) {
+            scan.Reset();
+            for (int i = 0; i < size; i++) {
+                process.burstTime = process.remainingTime = bursts[i];
+                scan.Submit(process, i);
+            }
+            scan.RunToCompletion();
+        }
+        double scanSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        same = heap.Timeline().size() == scan.Timeline().size() &&
+            std::equal(heap.Timeline().begin(), heap.Timeline().end(), scan.Timeline().begin(),
+                [](const RunSegment& a, const RunSegment& b) {
+                    return a.processIndex == b.processIndex && a.startTime == b.startTime && a.length == b.length;
+                });
+        double decisions = static_cast<double>(rounds) * 2 * size;
+        printf("engines n=%-5d heap %6.1f ns/decision, scan (%s) %6.1f ns/decision, timelines %s\n", size,
+            1e9 * heapSeconds / decisions, BestSelectKernel().name, 1e9 * scanSeconds / decisions,
+            same ? "match" : "DIFFER");
+        if (!same) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Same arrivals through a FIFO pool and through the SRTN task executor
+int RunExecutorBenchmark(const std::vector<std::wstring>& args) {
+    ExecutorBenchOptions options;
+    options.workers = static_cast<int>(GetNumber(args, L"--workers", options.workers));
+    options.tasks = static_cast<int>(GetNumber(args, L"--tasks", options.tasks));
+    options.load = GetDouble(args, L"--load", options.load);
+    options.longFraction = GetDouble(args, L"--long-fraction", options.longFraction);
+    options.shortMicros = static_cast<int>(GetNumber(args, L"--short-us", options.shortMicros));
+    options.longMicros = static_cast<int>(GetNumber(args, L"--long-us", options.longMicros));
+    options.chunkMicros = static_cast<int>(GetNumber(args, L"--chunk-us", options.chunkMicros));
+    options.seed = GetNumber(args, L"--seed", options.seed);
+
+    ExecutorBenchResult fifo = RunFifoPoolBenchmark(options);
+    PrintExecutorBench("fifo", fifo);
+    ExecutorBenchResult srtn = RunTaskExecutorBenchmark(options);
+    PrintExecutorBench("srtn", srtn);
+    if (srtn.p99Short > 0) {
+        printf("bench-executor: short-task p99 %.1fx lower than fifo\n", static_cast<double>(fifo.p99Short) / srtn.p99Short);
+    }
+    return 0;
+}
+
+int RunServe(const std::vector<std::wstring>& args) {
+    ServiceOptions options;
+    options.port = static_cast<unsigned short>(GetNumber(args, L"--port", options.port));
+    options.socketPath = Narrow(GetOption(args, L"--socket", L""));
+    options.rate = GetDouble(args, L"--rate", options.rate);
+    options.scheduler = GetSchedulerOptions(args);
+    options.checkpointPath = Narrow(GetOption(args, L"--checkpoint", L""));
+    options.checkpointEvery = static_cast<long long>(GetNumber(args, L"--checkpoint-every", 0));
+    options.resumePath = Narrow(GetOption(args, L"--resume", L""));
+    return RunSchedulerService(options);
+}
+
+int RunServeLoad(const std::vector<std::wstring>& args) {
+    ServiceLoadOptions options;
+    options.port = static_cast<unsigned short>(GetNumber(args, L"--port", options.port));
+    options.socketPath = Narrow(GetOption(args, L"--socket", L""));
+    options.connections = static_cast<int>(GetNumber(args, L"--connections", options.connections));
+    options.rounds = static_cast<int>(GetNumber(args, L"--rounds", options.rounds));
+    options.batch = static_cast<int>(GetNumber(args, L"--batch", options.batch));
+    return RunServiceLoadTest(options);
+}
+
+// Run real commands under SRTN on a fixed number of CPU slots
+int RunDispatchMode(const std::vector<std::wstring>& args) {
+    std::vector<DispatchJob> jobs;
+    std::string path = Narrow(args.size() > 2 ? args[2] : L"");
+    if (!LoadDispatchJobs(path, jobs) || jobs.empty()) {
+        fprintf(stderr, "dispatch: cannot read jobs from '%s' (expected \"<estimate-ms> <command>\" lines)\n", path.c_str());
+        return 1;
+    }
+    DispatchOptions options;
+    options.slots = static_cast<int>(GetNumber(args, L"--slots", options.slots));
+    options.quantumMs = static_cast<int>(GetNumber(args, L"--quantum-ms", options.quantumMs));
+
+    DispatchResult result = RunDispatch(jobs, options);
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const Process& p = result.processes[i];
+        printf("job %zu: estimate %d ms, cpu %d ms, turnaround %d ms, waiting %d ms, exit %d: %s\n",
+            i, jobs[i].estimateMs, p.burstTime, p.turnaroundTime, p.waitingTime, result.exitCodes[i],
+            jobs[i].command.c_str());
+    }
+    PrintSummary("dispatch", Summarize(result.processes, result.makespanMs));
+    printf("dispatch: %d slots, %lld preemptions, %zu timeline segments\n",
+        options.slots, result.preemptions, result.timeline.size());
+    if (std::find(args.begin(), args.end(), L"--print-timeline") != args.end()) {
+        for (const auto& segment : result.timeline) {
+            printf("segment: job %d from %d ms for %d ms\n", segment.processIndex, segment.startTime, segment.length);
+        }
+    }
+    return 0;
+}
+
+int RunVerify(const std::vector<std::wstring>& args) {
+    VerifyOptions options;
+    options.cases = GetNumber(args, L"--cases", options.cases);
+    options.seed = GetNumber(args, L"--seed", options.seed);
+    options.threads = static_cast<int>(GetNumber(args, L"--threads", options.threads));
+    options.maxProcesses = static_cast<int>(GetNumber(args, L"--max-processes", options.maxProcesses));
+    options.maxBurst = static_cast<int>(GetNumber(args, L"--max-burst", options.maxBurst));
+
+    VerifyReport report = RunDifferentialCheck(options);
+    printf("verify: %llu cases in %.2f s (%.0f cases/s)\n",
+        static_cast<unsigned long long>(report.casesRun), report.seconds,
+        report.seconds > 0 ? report.casesRun / report.seconds : 0.0);
+
+    if (!report.diverged) {
+        printf("verify: all engines match the reference\n");
+        return 0;
+    }
+    printf("verify: engine '%s' diverged on case %llu (seed %llu)\n", report.engine.c_str(),
+        static_cast<unsigned long long>(report.caseNumber), static_cast<unsigned long long>(options.seed));
+    printf("verify: %s\n", report.detail.c_str());
+    printf("verify: minimized repro:\n%s", FormatCase(report.repro).c_str());
+    return 1;
+}
+
+struct HeadlessMode {
+    const wchar_t* name;
+    int (*run)(const std::vector<std::wstring>& args);
+};
+
+const HeadlessMode MODES[] = {
+    { L"--verify", RunVerify },
+    { L"--simulate", RunSimulate },
+    { L"--sweep", RunSweep },
+    { L"--write-trace", RunWriteTrace },
+    { L"--load-trace", RunLoadTrace },
+    { L"--predict", RunPredict },
+    { L"--starvation", RunStarvation },
+    { L"--io", RunIo },
+    { L"--deadlines", RunDeadlines },
+    { L"--admission", RunAdmission },
+    { L"--fair-share", RunFairShare },
+    { L"--bench-submit", RunSubmitBenchmark },
+    { L"--bench-executor", RunExecutorBenchmark },
+    { L"--bench-select", RunSelectBenchmark },
+    { L"--paced", RunPaced },
+    { L"--runner", RunRunnerMode },
+    { L"--checkpoint-run", RunCheckpointRun },
+    { L"--resume", RunResume },
+    { L"--what-if", RunWhatIf },
+    { L"--timeline", RunTimeline },
+    { L"--save-timeline", RunSaveTimeline },
+    { L"--replay", RunReplay },
+    { L"--stream", RunStream },
+    { L"--serve", RunServe },
+    { L"--serve-load", RunServeLoad },
+    { L"--dispatch", RunDispatchMode },
+};
+
+const HeadlessMode* FindMode(const std::vector<std::wstring>& args) {
+    if (args.size() < 2) {
+        return nullptr;
+    }
+    for (const auto& mode : MODES) {
+        if (args[1] == mode.name) {
+            return &mode;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+bool IsHeadlessCommand(const std::vector<std::wstring>& args) {
+    return FindMode(args) != nullptr;
+}
+
+int RunHeadless(const std::vector<std::wstring>& args) {
+    const HeadlessMode* mode = FindMode(args);
+    if (mode == nullptr) {
+        return -1;
+    }
+    int result = mode->run(args);
+
+    // Any mode can dump the hot-path counters it accumulated
+    std::wstring format = GetOption(args, L"--metrics", L"");
+    if (format == L"prom") {
+        printf("%s", MetricsPrometheus().c_str());
+    }
+    else if (format == L"json") {
+        printf("%s\n", MetricsJson().c_str());
+    }
+    return result;
+}
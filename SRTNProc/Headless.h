@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Command-line modes that run without the window (verification, benchmarks).
+// args[0] is the executable path, as returned by CommandLineToArgvW.
+bool IsHeadlessCommand(const std::vector<std::wstring>& args);
+
+// Runs the requested mode and returns the process exit code
+int RunHeadless(const std::vector<std::wstring>& args);
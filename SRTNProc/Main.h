@@ -1,3 +1,3 @@
-#pragma once
-
+#pragma once
+
 void crash_me(); // We JUST CALL this function unless we need it! DON'T USE THIS IN NORMAL CASE!!!
\ No newline at end of file
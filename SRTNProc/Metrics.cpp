@@ -0,0 +1,188 @@
+#include "Metrics.h"
+
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace {
+
+struct MetricInfo {
+    const char* name;
+    const char* help;
+};
+
+const MetricInfo COUNTERS[COUNTER_COUNT] = {
+    { "decisions", "Scheduling decisions taken with processes ready" },
+    { "dispatches", "Processes put on the CPU" },
+    { "preemptions", "Running processes switched out before finishing" },
+    { "switches", "Dispatches of a different process than the last one to run" },
+    { "forced_dispatches", "Dispatches made to honour the maximum wait" },
+    { "arrivals", "Processes admitted to the ready set" },
+    { "completions", "Processes completed" },
+    { "io_requests", "CPU bursts that ended in a device request" },
+    { "deadline_misses", "Processes seen unfinished past their deadline" },
+    { "slack_overrides", "Dispatches made because a process ran out of slack" },
+    { "admission_deferrals", "Arrivals held back by admission control" },
+    { "admission_rejects", "Arrivals refused by admission control" },
+    { "admission_sheds", "Ready processes dropped by admission control to make room" },
+    { "inbox_posts", "Processes drained from the submission queue" },
+    { "ticks", "Time units advanced by the engine runner" },
+    { "service_requests", "Protocol requests handled by the service" },
+};
+
+const MetricInfo HISTOGRAMS[HISTOGRAM_COUNT] = {
+    { "ready_depth", "Ready processes at each decision" },
+    { "lock_wait_us", "Microseconds spent acquiring the process mutex" },
+    { "lock_hold_us", "Microseconds the process mutex was held" },
+    { "tick_lateness_us", "Microseconds each paced tick was reached after its deadline" },
+};
+
+std::mutex g_shardMutex;
+std::vector<std::unique_ptr<MetricShard>> g_shards;
+
+// Not a shard counter: registering a shard allocates
+std::atomic<uint64_t> g_heapAllocations(0);
+
+// Upper bound of a bucket, inclusive
+uint64_t BucketLimit(int bucket) {
+    return bucket == 0 ? 0 : bucket >= 64 ? UINT64_MAX : (uint64_t(1) << bucket) - 1;
+}
+
+} // namespace
+
+MetricShard* RegisterMetricShard() {
+    std::unique_ptr<MetricShard> shard(new MetricShard());
+    for (auto& counter : shard->counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    for (int h = 0; h < HISTOGRAM_COUNT; h++) {
+        for (auto& bucket : shard->buckets[h]) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        shard->sums[h].store(0, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(g_shardMutex);
+    g_shards.push_back(std::move(shard));
+    return g_shards.back().get();
+}
+
+uint64_t ReadCounter(Counter counter) {
+    std::lock_guard<std::mutex> lock(g_shardMutex);
+    uint64_t total = 0;
+    for (const auto& shard : g_shards) {
+        total += shard->counters[static_cast<int>(counter)].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+HistogramSnapshot ReadHistogram(Histogram histogram) {
+    int h = static_cast<int>(histogram);
+    HistogramSnapshot snapshot;
+    std::lock_guard<std::mutex> lock(g_shardMutex);
+    for (const auto& shard : g_shards) {
+        for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+            uint64_t value = shard->buckets[h][b].load(std::memory_order_relaxed);
+            snapshot.buckets[b] += value;
+            snapshot.count += value;
+        }
+        snapshot.sum += shard->sums[h].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+std::string MetricsPrometheus() {
+    std::string out;
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        std::string name = std::string("srtn_") + COUNTERS[c].name + "_total";
+        out += "# HELP " + name + " " + COUNTERS[c].help + "\n";
+        out += "# TYPE " + name + " counter\n";
+        out += name + " " + std::to_string(ReadCounter(static_cast<Counter>(c))) + "\n";
+    }
+    for (int h = 0; h < HISTOGRAM_COUNT; h++) {
+        std::string name = std::string("srtn_") + HISTOGRAMS[h].name;
+        HistogramSnapshot snapshot = ReadHistogram(static_cast<Histogram>(h));
+        out += "# HELP " + name + " " + HISTOGRAMS[h].help + "\n";
+        out += "# TYPE " + name + " histogram\n";
+
+        // Buckets are cumulative; stop after the last one that holds anything
+        int last = HISTOGRAM_BUCKETS - 1;
+        while (last > 0 && snapshot.buckets[last] == 0) {
+            last--;
+        }
+        uint64_t cumulative = 0;
+        for (int b = 0; b <= last && b < 64; b++) {
+            cumulative += snapshot.buckets[b];
+            out += name + "_bucket{le=\"" + std::to_string(BucketLimit(b)) + "\"} " + std::to_string(cumulative) + "\n";
+        }
+        out += name + "_bucket{le=\"+Inf\"} " + std::to_string(snapshot.count) + "\n";
+        out += name + "_sum " + std::to_string(snapshot.sum) + "\n";
+        out += name + "_count " + std::to_string(snapshot.count) + "\n";
+    }
+    return out;
+}
+
+std::string MetricsJson() {
+    std::string out = "{\"counters\":{";
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        out += c > 0 ? "," : "";
+        out += std::string("\"") + COUNTERS[c].name + "\":" + std::to_string(ReadCounter(static_cast<Counter>(c)));
+    }
+    out += "},\"histograms\":{";
+    for (int h = 0; h < HISTOGRAM_COUNT; h++) {
+        HistogramSnapshot snapshot = ReadHistogram(static_cast<Histogram>(h));
+        out += h > 0 ? "," : "";
+        out += std::string("\"") + HISTOGRAMS[h].name + "\":{\"count\":" + std::to_string(snapshot.count) +
+            ",\"sum\":" + std::to_string(snapshot.sum) + ",\"buckets\":[";
+
+        // Non-empty buckets only, each with its inclusive upper bound
+        bool first = true;
+        for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+            if (snapshot.buckets[b] == 0) {
+                continue;
+            }
+            out += first ? "" : ",";
+            out += "{\"le\":" + std::to_string(BucketLimit(b)) + ",\"count\":" + std::to_string(snapshot.buckets[b]) + "}";
+            first = false;
+        }
+        out += "]}";
+    }
+    out += "}}";
+    return out;
+}
+
+uint64_t HeapAllocations() {
+    return g_heapAllocations.load(std::memory_order_relaxed);
+}
+
+#if SRTN_METRICS
+// Counting replacements for the global allocation functions; the array forms
+// forward to these
+void* operator new(size_t size) {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size > 0 ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+#endif
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Hot-path instrumentation. Build with SRTN_METRICS=0 to compile every probe
+// away; the readers then report zeros.
+#ifndef SRTN_METRICS
+#define SRTN_METRICS 1
+#endif
+
+enum class Counter {
+    Decisions,          // Dispatch calls with a non-empty ready set
+    Dispatches,         // Processes put on the CPU
+    Preemptions,
+    Switches,
+    ForcedDispatches,   // Dispatches made to honour maxWait
+    Arrivals,
+    Completions,
+    IoRequests,         // CPU bursts that ended in a device request
+    DeadlineMisses,     // Processes seen unfinished past their deadline
+    SlackOverrides,     // Dispatches made because a process ran out of slack
+    AdmissionDeferrals, // Arrivals held back by admission control
+    AdmissionRejects,
+    AdmissionSheds,     // Ready processes dropped to make room
+    InboxPosts,         // Processes drained from the submission queue
+    Ticks,              // Time units advanced by the EngineRunner
+    ServiceRequests,
+    COUNT
+};
+
+enum class Histogram {
+    ReadyDepth,         // Ready processes at each decision
+    LockWaitMicros,     // Time to acquire g_processMutex or the EngineRunner lock
+    LockHoldMicros,     // Time either is held
+    TickLatenessMicros, // How late each paced tick was reached
+    COUNT
+};
+
+const int COUNTER_COUNT = static_cast<int>(Counter::COUNT);
+const int HISTOGRAM_COUNT = static_cast<int>(Histogram::COUNT);
+const int HISTOGRAM_BUCKETS = 65;   // Bucket b > 0 holds [2^(b-1), 2^b)
+
+// One per thread, written only by its owner, so updates are a relaxed load
+// and store with no read-modify-write. Readers sum every shard.
+struct MetricShard {
+    std::atomic<uint64_t> counters[COUNTER_COUNT];
+    std::atomic<uint64_t> buckets[HISTOGRAM_COUNT][HISTOGRAM_BUCKETS];
+    std::atomic<uint64_t> sums[HISTOGRAM_COUNT];
+};
+
+// Allocates and registers the calling thread's shard; shards outlive their thread
+MetricShard* RegisterMetricShard();
+
+inline MetricShard& LocalMetricShard() {
+    thread_local MetricShard* shard = RegisterMetricShard();
+    return *shard;
+}
+
+inline int MetricBucket(uint64_t value) {
+    if (value == 0) {
+        return 0;
+    }
+#ifdef _MSC_VER
+    unsigned long bit;
+    _BitScanReverse64(&bit, value);
+    return static_cast<int>(bit) + 1;
+#else
+    return 64 - __builtin_clzll(value);
+#endif
+}
+
+inline void MetricAdd(Counter counter, uint64_t amount = 1) {
+#if SRTN_METRICS
+    std::atomic<uint64_t>& slot = LocalMetricShard().counters[static_cast<int>(counter)];
+    slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+#else
+    (void)counter;
+    (void)amount;
+#endif
+}
+
+inline void MetricObserve(Histogram histogram, uint64_t value) {
+#if SRTN_METRICS
+    MetricShard& shard = LocalMetricShard();
+    int h = static_cast<int>(histogram);
+    std::atomic<uint64_t>& bucket = shard.buckets[h][MetricBucket(value)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    shard.sums[h].store(shard.sums[h].load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+#else
+    (void)histogram;
+    (void)value;
+#endif
+}
+
+// Observes the microseconds between construction and destruction
+class MetricTimer {
+public:
+#if SRTN_METRICS
+    explicit MetricTimer(Histogram histogram)
+        : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+    ~MetricTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - m_start;
+        MetricObserve(m_histogram, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+#else
+    explicit MetricTimer(Histogram) {}
+#endif
+    MetricTimer(const MetricTimer&) = delete;
+    MetricTimer& operator=(const MetricTimer&) = delete;
+
+#if SRTN_METRICS
+private:
+    Histogram m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+#endif
+};
+
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t buckets[HISTOGRAM_BUCKETS] = {};
+};
+
+// Totals over every thread; safe to call at any time from any thread
+uint64_t ReadCounter(Counter counter);
+HistogramSnapshot ReadHistogram(Histogram histogram);
+
+// Prometheus text exposition format, and the same data as one JSON object
+std::string MetricsPrometheus();
+std::string MetricsJson();
+
+// Calls to the global operator new so far, from every thread. Counted by a
+// replacement operator new, so zero when built with SRTN_METRICS=0.
+uint64_t HeapAllocations();
@@ -0,0 +1,59 @@
+#include "NameTable.h"
+
+#include <algorithm>
+
+namespace {
+
+// Characters per arena chunk; longer names get a chunk of their own
+const size_t CHUNK_CHARS = 64 * 1024;
+
+} // namespace
+
+NameTable::NameTable() : m_arena(CHUNK_CHARS * sizeof(wchar_t)) {
+    Intern(std::wstring_view());
+}
+
+const wchar_t* NameTable::Store(std::wstring_view text) {
+    wchar_t* stored = m_arena.Allocate<wchar_t>(text.size() + 1);
+    std::copy(text.begin(), text.end(), stored);
+    stored[text.size()] = L'\0';
+    return stored;
+}
+
+NameId NameTable::Intern(std::wstring_view text) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_ids.find(text);
+    if (found != m_ids.end()) {
+        return found->second;
+    }
+    // The key must view the arena copy, not the caller's buffer
+    std::wstring_view stored(Store(text), text.size());
+    NameId id = static_cast<NameId>(m_names.size());
+    m_names.push_back(stored);
+    m_ids.emplace(stored, id);
+    return id;
+}
+
+const wchar_t* NameTable::Text(NameId id) const {
+    return View(id).data();
+}
+
+std::wstring_view NameTable::View(NameId id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return id < m_names.size() ? m_names[id] : m_names[EMPTY_NAME];
+}
+
+size_t NameTable::Count() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_names.size();
+}
+
+size_t NameTable::ArenaBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_arena.BytesReserved();
+}
+
+NameTable& ProcessNames() {
+    static NameTable table;
+    return table;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Arena.h"
+
+// Handle of an interned process name. Equal names get equal ids, so names
+// compare and hash as integers, and ids are dense from 0 for table lookups.
+typedef uint32_t NameId;
+
+// The empty name, interned first by every table
+const NameId EMPTY_NAME = 0;
+
+// Append-only string table. Text is copied once into large arena chunks that
+// never move, so a trace repeating a few thousand names across millions of
+// processes makes a few thousand copies and no per-process allocations.
+// Thread-safe; returned text stays valid for the table's lifetime.
+class NameTable {
+public:
+    NameTable();
+    NameTable(const NameTable&) = delete;
+    NameTable& operator=(const NameTable&) = delete;
+
+    NameId Intern(std::wstring_view text);
+
+    // Null-terminated, for Win32 text calls
+    const wchar_t* Text(NameId id) const;
+    std::wstring_view View(NameId id) const;
+
+    size_t Count() const;
+    // Arena bytes reserved for text, excluding the lookup index
+    size_t ArenaBytes() const;
+
+private:
+    const wchar_t* Store(std::wstring_view text);
+
+    mutable std::mutex m_mutex;
+    MonotonicArena m_arena;
+    std::vector<std::wstring_view> m_names;     // By id; views into the arena
+    std::unordered_map<std::wstring_view, NameId> m_ids;
+};
+
+// The table every Process name refers to
+NameTable& ProcessNames();
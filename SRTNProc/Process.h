@@ -0,0 +1,60 @@
+#pragma once
+
+#include <type_traits>
+
+#include "NameTable.h"
+
+// Time and index widths are template parameters so small workloads stay
+// cache-compact and long traces get 64-bit time (see EngineWidths in
+// Workload.h). The plain names are the int instantiations the GUI uses.
+template <typename Time>
+struct BasicProcess {
+    NameId name;                    // Process name, interned in ProcessNames()
+    Time burstTime;                 // Burst time
+    Time remainingTime;             // Remaining time
+    Time appearingTime;             // Appearing time
+    Time waitingTime;               // Waiting time
+    Time turnaroundTime;            // Turn-around time
+    bool completed;
+};
+
+typedef BasicProcess<int> Process;
+
+// Copied by memcpy through vector growth, checkpoints and the submit queue
+static_assert(std::is_trivially_copyable<Process>::value, "Process must stay trivially copyable");
+
+// The same process at another time width; the caller checks the range
+template <typename To, typename From>
+BasicProcess<To> ProcessCast(const BasicProcess<From>& p) {
+    return { p.name, static_cast<To>(p.burstTime), static_cast<To>(p.remainingTime), static_cast<To>(p.appearingTime),
+        static_cast<To>(p.waitingTime), static_cast<To>(p.turnaroundTime), p.completed };
+}
+
+// A CPU burst followed by an I/O burst: cpu units on the CPU, then io units
+// of service on a simulated device. A negative device ends the job instead.
+template <typename Time>
+struct BasicBurst {
+    Time cpu;
+    int device;
+    Time io;
+};
+
+typedef BasicBurst<int> Burst;
+
+template <typename Time, typename Index>
+struct BasicExecutionStep {
+    Index processIndex;  // Index of the process that was executing
+    Time timeUnit;       // Time unit when this execution occurred
+};
+
+typedef BasicExecutionStep<int, int> ExecutionStep;
+
+// A maximal run of consecutive time units given to one process
+template <typename Time, typename Index>
+struct BasicRunSegment {
+    Index processIndex;
+    Time startTime;
+    Time length;
+};
+
+typedef BasicRunSegment<int, int> RunSegment;
@@ -0,0 +1,120 @@
+#include "Report.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+template <typename T>
+T Percentile(std::vector<T>& sample, double percent) {
+    if (sample.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * sample.size()));
+    rank = std::min(std::max<size_t>(rank, 1), sample.size()) - 1;
+    std::nth_element(sample.begin(), sample.begin() + rank, sample.end());
+    return sample[rank];
+}
+
+template <typename Time>
+RunSummary Summarize(const std::vector<BasicProcess<Time>>& processes, long long makespan) {
+    RunSummary summary;
+    summary.processes = processes.size();
+    summary.makespan = makespan;
+
+    std::vector<Time> turnaround;
+    turnaround.reserve(processes.size());
+    double waiting = 0;
+    for (const auto& process : processes) {
+        if (!process.completed) {
+            continue;
+        }
+        turnaround.push_back(process.turnaroundTime);
+        waiting += process.waitingTime;
+    }
+    summary.completed = turnaround.size();
+    if (turnaround.empty()) {
+        return summary;
+    }
+
+    double total = 0;
+    for (Time t : turnaround) {
+        total += t;
+    }
+    summary.meanTurnaround = total / turnaround.size();
+    summary.meanWaiting = waiting / turnaround.size();
+    summary.maxTurnaround = *std::max_element(turnaround.begin(), turnaround.end());
+    summary.p50Turnaround = Percentile(turnaround, 50);
+    summary.p99Turnaround = Percentile(turnaround, 99);
+    summary.p999Turnaround = Percentile(turnaround, 99.9);
+    return summary;
+}
+
+template <typename Time>
+DeadlineSummary SummarizeDeadlines(const std::vector<BasicProcess<Time>>& processes,
+    const std::vector<Time>& arrivals, const std::vector<Time>& deadlines, Time noDeadline) {
+    DeadlineSummary summary;
+    std::vector<Time> tardiness;
+    double total = 0;
+    for (size_t i = 0; i < deadlines.size() && i < processes.size(); i++) {
+        if (deadlines[i] == noDeadline || !processes[i].completed) {
+            continue;
+        }
+        summary.withDeadline++;
+        Time late = arrivals[i] + processes[i].turnaroundTime - deadlines[i];
+        if (late > 0) {
+            tardiness.push_back(late);
+            total += late;
+        }
+    }
+    summary.missed = tardiness.size();
+    if (summary.withDeadline > 0) {
+        summary.meanTardiness = total / summary.withDeadline;
+    }
+    if (!tardiness.empty()) {
+        summary.maxTardiness = *std::max_element(tardiness.begin(), tardiness.end());
+        summary.p50Tardiness = Percentile(tardiness, 50);
+        summary.p99Tardiness = Percentile(tardiness, 99);
+    }
+    return summary;
+}
+
+template int32_t Percentile(std::vector<int32_t>& sample, double percent);
+template int64_t Percentile(std::vector<int64_t>& sample, double percent);
+template RunSummary Summarize(const std::vector<BasicProcess<int32_t>>& processes, long long makespan);
+template RunSummary Summarize(const std::vector<BasicProcess<int64_t>>& processes, long long makespan);
+template DeadlineSummary SummarizeDeadlines(const std::vector<BasicProcess<int32_t>>& processes,
+    const std::vector<int32_t>& arrivals, const std::vector<int32_t>& deadlines, int32_t noDeadline);
+template DeadlineSummary SummarizeDeadlines(const std::vector<BasicProcess<int64_t>>& processes,
+    const std::vector<int64_t>& arrivals, const std::vector<int64_t>& deadlines, int64_t noDeadline);
+
+void PrintSummary(const char* label, const RunSummary& summary) {
+    printf("%s: %zu/%zu completed, makespan %lld\n", label, summary.completed, summary.processes, summary.makespan);
+    printf("%s: turnaround mean %.2f p50 %lld p99 %lld p99.9 %lld max %lld, waiting mean %.2f\n", label,
+        summary.meanTurnaround, summary.p50Turnaround, summary.p99Turnaround, summary.p999Turnaround,
+        summary.maxTurnaround, summary.meanWaiting);
+}
+
+void PrintStats(const char* label, const SchedulerStats& stats, long long makespan) {
+    double lost = makespan > 0 ? 100.0 * stats.switchTime / makespan : 0.0;
+    printf("%s: %lld switches, %lld preemptions, %lld units lost to switching (%.2f%% of makespan), busy %lld\n",
+        label, stats.switches, stats.preemptions, stats.switchTime, lost, stats.busyTime);
+}
+
+void PrintDeadlines(const char* label, const DeadlineSummary& summary) {
+    double rate = summary.withDeadline > 0 ? 100.0 * summary.missed / summary.withDeadline : 0.0;
+    printf("%s: %zu/%zu deadlines missed (%.2f%%), tardiness mean %.2f, of misses p50 %lld p99 %lld max %lld\n",
+        label, summary.missed, summary.withDeadline, rate, summary.meanTardiness, summary.p50Tardiness,
+        summary.p99Tardiness, summary.maxTardiness);
+}
+
+void PrintDeviceStats(const char* label, const SchedulerStats& stats, const std::vector<DeviceStats>& devices,
+    long long makespan) {
+    double span = makespan > 0 ? static_cast<double>(makespan) : 1.0;
+    printf("%s: cpu %.1f%% busy, %lld I/O requests\n", label, 100.0 * stats.busyTime / span, stats.ioBlocks);
+    for (size_t d = 0; d < devices.size(); d++) {
+        const DeviceStats& device = devices[d];
+        double wait = device.requests > 0 ? static_cast<double>(device.queueTime) / device.requests : 0.0;
+        printf("%s: device %zu %.1f%% busy, %lld requests, mean queue wait %.2f, max queue %zu\n",
+            label, d, 100.0 * device.busyTime / span, device.requests, wait, device.maxQueue);
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Scheduler.h"
+
+struct RunSummary {
+    size_t processes = 0;
+    size_t completed = 0;
+    double meanTurnaround = 0;
+    double meanWaiting = 0;
+    long long p50Turnaround = 0;
+    long long p99Turnaround = 0;
+    long long p999Turnaround = 0;
+    long long maxTurnaround = 0;
+    long long makespan = 0;     // Clock when the run ended
+};
+
+// Turnaround statistics over the completed processes.
+// Instantiated for int32_t and int64_t time.
+template <typename Time>
+RunSummary Summarize(const std::vector<BasicProcess<Time>>& processes, long long makespan);
+
+// Deadline outcomes over the processes that have one. Tardiness is how long
+// after its deadline a process completed; on-time processes count as 0.
+struct DeadlineSummary {
+    size_t withDeadline = 0;
+    size_t missed = 0;
+    double meanTardiness = 0;
+    long long p50Tardiness = 0;     // Percentiles over the missed processes
+    long long p99Tardiness = 0;
+    long long maxTardiness = 0;
+};
+
+// Instantiated for int32_t and int64_t time, like Summarize
+template <typename Time>
+DeadlineSummary SummarizeDeadlines(const std::vector<BasicProcess<Time>>& processes,
+    const std::vector<Time>& arrivals, const std::vector<Time>& deadlines, Time noDeadline);
+
+// Nearest-rank percentile (0..100) of an unsorted sample; reorders the sample
+template <typename T>
+T Percentile(std::vector<T>& sample, double percent);
+
+void PrintSummary(const char* label, const RunSummary& summary);
+void PrintStats(const char* label, const SchedulerStats& stats, long long makespan);
+void PrintDeadlines(const char* label, const DeadlineSummary& summary);
+// CPU and per-device utilization over the makespan, with queueing per device
+void PrintDeviceStats(const char* label, const SchedulerStats& stats, const std::vector<DeviceStats>& devices,
+    long long makespan);
@@ -0,0 +1,102 @@
+#include "ScanEngine.h"
+
+#include <algorithm>
+#include <climits>
+
+#include "SelectKernel.h"
+
+void ScanEngine::Reset() {
+    m_processes.clear();
+    m_arrival.clear();
+    m_remaining.clear();
+    m_order.clear();
+    m_timeline.clear();
+    m_nextArrival = 0;
+    m_low = 0;
+    m_high = 0;
+    m_now = 0;
+}
+
+int ScanEngine::Submit(const Process& process, int arrivalTime) {
+    int index = static_cast<int>(m_processes.size());
+    m_processes.push_back(process);
+    m_arrival.push_back(std::max(arrivalTime, m_now));
+    m_remaining.push_back(INT_MAX);
+    return index;
+}
+
+void ScanEngine::Admit() {
+    while (m_nextArrival < m_order.size() && m_arrival[m_order[m_nextArrival]] <= m_now) {
+        int index = m_order[m_nextArrival++];
+        if (m_processes[index].remainingTime <= 0) {
+            Complete(index);
+            continue;
+        }
+        m_remaining[index] = m_processes[index].remainingTime;
+        m_high = std::max(m_high, static_cast<size_t>(index) + 1);
+    }
+}
+
+void ScanEngine::Record(int processIndex, int length) {
+    if (!m_timeline.empty() &&
+        m_timeline.back().processIndex == processIndex &&
+        m_timeline.back().startTime + m_timeline.back().length == m_now) {
+        m_timeline.back().length += length;
+    }
+    else {
+        m_timeline.push_back({ processIndex, m_now, length });
+    }
+    m_now += length;
+}
+
+void ScanEngine::Complete(int index) {
+    Process& p = m_processes[index];
+    p.remainingTime = 0;
+    p.completed = true;
+    p.turnaroundTime = m_now - m_arrival[index];
+    p.waitingTime = p.turnaroundTime - p.burstTime;
+    m_remaining[index] = INT_MAX;
+}
+
+void ScanEngine::RunToCompletion() {
+    // Submissions since the last run join the arrival order
+    m_order.resize(m_processes.size());
+    for (size_t i = m_nextArrival; i < m_order.size(); i++) {
+        m_order[i] = static_cast<int>(i);
+    }
+    std::stable_sort(m_order.begin() + m_nextArrival, m_order.end(),
+        [this](int a, int b) { return m_arrival[a] < m_arrival[b]; });
+
+    for (;;) {
+        Admit();
+        // Early indices complete and arrivals mostly come in index order, so
+        // the live window is usually much smaller than the array
+        while (m_low < m_high && m_remaining[m_low] == INT_MAX) {
+            m_low++;
+        }
+        int pick = Argmin(m_remaining.data() + m_low, m_high - m_low);
+        if (pick >= 0) {
+            pick += static_cast<int>(m_low);
+        }
+        int nextArrival = m_nextArrival < m_order.size() ? m_arrival[m_order[m_nextArrival]] : -1;
+        if (pick < 0) {
+            if (nextArrival < 0) {
+                return;
+            }
+            m_now = nextArrival;
+            continue;
+        }
+
+        // Nothing changes until the pick completes or the next arrival
+        int length = m_remaining[pick];
+        if (nextArrival >= 0) {
+            length = std::min(length, nextArrival - m_now);
+        }
+        Record(pick, length);
+        m_remaining[pick] -= length;
+        m_processes[pick].remainingTime = m_remaining[pick];
+        if (m_remaining[pick] == 0) {
+            Complete(pick);
+        }
+    }
+}
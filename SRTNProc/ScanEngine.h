@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+#include "Process.h"
+
+// Brute-force SRTN: remaining times live in one contiguous array, with
+// completed and not-yet-arrived processes held at INT_MAX, and every decision
+// is a SIMD argmin over the whole array (see SelectKernel.h). The running
+// process competes in the same scan, so there is no heap to maintain; that
+// wins when the ready set is dense and reorders at nearly every decision.
+// Same semantics as SrtnEngine with default options.
+class ScanEngine {
+public:
+    void Reset();
+
+    // Indices are assigned in submission order
+    int Submit(const Process& process, int arrivalTime);
+    void RunToCompletion();
+
+    int Now() const { return m_now; }
+    const std::vector<Process>& Processes() const { return m_processes; }
+    const std::vector<RunSegment>& Timeline() const { return m_timeline; }
+
+private:
+    void Admit();
+    void Record(int processIndex, int length);
+    void Complete(int index);
+
+    std::vector<Process> m_processes;
+    std::vector<int> m_arrival;
+    std::vector<int> m_remaining;   // INT_MAX unless ready or running
+    std::vector<int> m_order;       // Indices by (arrival, index)
+    std::vector<RunSegment> m_timeline;
+    size_t m_nextArrival = 0;
+    size_t m_low = 0;               // Entries outside [m_low, m_high) are all INT_MAX
+    size_t m_high = 0;
+    int m_now = 0;
+};
@@ -0,0 +1,93 @@
+#include "ScheduleGenerator.h"
+
+#include <algorithm>
+
+namespace {
+
+// Slices that produce nothing double up to this many steps, so a long gap
+// between arrivals takes fewer slices while the busy slice after it still
+// holds a bounded number of segments
+const int MAX_SPAN_STEPS = 64;
+
+} // namespace
+
+template <typename Time, typename Index>
+BasicScheduleGenerator<Time, Index>::BasicScheduleGenerator(Engine& engine, Time step)
+    : m_engine(engine), m_step(std::max<Time>(1, step)), m_span(m_step) {
+    m_engine.RecordCompletions(&m_completions);
+}
+
+template <typename Time, typename Index>
+BasicScheduleGenerator<Time, Index>::~BasicScheduleGenerator() {
+    m_engine.RecordCompletions(nullptr);
+}
+
+template <typename Time, typename Index>
+bool BasicScheduleGenerator<Time, Index>::Next(Event& event) {
+    for (;;) {
+        const auto& timeline = m_engine.Timeline();
+        // While the engine runs, its last segment may still be extended
+        size_t final = timeline.size() - (m_working && !timeline.empty() ? 1 : 0);
+        if (m_completion < m_completions.size()) {
+            Index index = m_completions[m_completion];
+            Time at = m_engine.Arrivals()[index] + m_engine.ProcessAt(index).turnaroundTime;
+            // A completion ends the segment before it; later segments start at or after the clock
+            if (m_position == timeline.size() || at <= timeline[m_position].startTime) {
+                m_completion++;
+                event.kind = ScheduleEventKind::Completion;
+                event.segment = { index, at, 0 };
+                return true;
+            }
+        }
+        if (m_position < final) {
+            event.kind = ScheduleEventKind::Segment;
+            event.segment = timeline[m_position++];
+            return true;
+        }
+        if (!m_working) {
+            return false;
+        }
+        Refill();
+    }
+}
+
+template <typename Time, typename Index>
+size_t BasicScheduleGenerator<Time, Index>::Take(size_t count, std::vector<Event>& out) {
+    Event event;
+    size_t taken = 0;
+    while (taken < count && Next(event)) {
+        out.push_back(event);
+        taken++;
+    }
+    return taken;
+}
+
+// Runs one more slice, once everything final has been produced
+template <typename Time, typename Index>
+void BasicScheduleGenerator<Time, Index>::Refill() {
+    // Only the segment the engine may still extend is left to produce, and
+    // the completions that end it
+    m_engine.TrimTimeline();
+    m_position = 0;
+    m_completions.erase(m_completions.begin(), m_completions.begin() + m_completion);
+    m_completion = 0;
+
+    size_t segments = m_engine.Timeline().size();
+    size_t completions = m_completions.size();
+    m_working = m_engine.RunUntil(static_cast<Time>(std::min<long long>(
+        static_cast<long long>(m_engine.Now()) + m_span, m_engine.MAX_TIME - 1)));
+    m_maxHeld = std::max(m_maxHeld, m_engine.Timeline().size() + m_completions.size());
+    if (m_engine.Timeline().size() == segments && m_completions.size() == completions) {
+        m_span = static_cast<Time>(std::min<long long>(static_cast<long long>(m_span) * 2,
+            static_cast<long long>(m_step) * MAX_SPAN_STEPS));
+    }
+    else {
+        m_span = m_step;
+    }
+}
+
+template class BasicScheduleGenerator<int, int>;
+template class BasicScheduleGenerator<int32_t, uint16_t>;
+template class BasicScheduleGenerator<int32_t, uint32_t>;
+template class BasicScheduleGenerator<int64_t, uint16_t>;
+template class BasicScheduleGenerator<int64_t, uint32_t>;
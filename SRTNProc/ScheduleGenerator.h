@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "Scheduler.h"
+
+enum class ScheduleEventKind {
+    Segment,        // A run segment or context switch, once it can no longer grow
+    Completion,     // A process finished its last burst
+};
+
+template <typename Time, typename Index>
+struct BasicScheduleEvent {
+    ScheduleEventKind kind;
+    // A segment as in the engine's timeline; for a completion, the process
+    // and the time it completed, with length 0
+    BasicRunSegment<Time, Index> segment;
+};
+
+// Pull-based view of a run: the engine advances only when a consumer asks for
+// an event no slice run so far has produced, `step` time units at a time
+// (more across idle stretches). Events come in time order, a completion
+// before any segment starting at its time. Segments already pulled are trimmed
+// from the engine's timeline, so memory stays at about one step's worth of
+// events however long the run is, and a consumer that stops early leaves the
+// rest unsimulated. The engine must be loaded with its work and outlive the
+// generator, and nothing else may advance it meanwhile; segments it already
+// held are produced first. The members are defined in ScheduleGenerator.cpp
+// and instantiated there for every engine width pair.
+template <typename Time, typename Index>
+class BasicScheduleGenerator {
+public:
+    typedef BasicSrtnEngine<Time, Index> Engine;
+    typedef BasicScheduleEvent<Time, Index> Event;
+
+    static constexpr Time DEFAULT_STEP = 4096;
+
+    // Input iterator over the remaining events, for range-for
+    class Iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef Event value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Event* pointer;
+        typedef const Event& reference;
+
+        Iterator() = default;
+        explicit Iterator(BasicScheduleGenerator* generator) : m_generator(generator) { ++*this; }
+
+        const Event& operator*() const { return m_event; }
+        const Event* operator->() const { return &m_event; }
+        Iterator& operator++() {
+            if (!m_generator->Next(m_event)) {
+                m_generator = nullptr;
+            }
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return m_generator == other.m_generator; }
+        bool operator!=(const Iterator& other) const { return m_generator != other.m_generator; }
+
+    private:
+        BasicScheduleGenerator* m_generator = nullptr;
+        Event m_event = {};
+    };
+
+    explicit BasicScheduleGenerator(Engine& engine, Time step = DEFAULT_STEP);
+    // Stops the engine logging completions
+    ~BasicScheduleGenerator();
+    BasicScheduleGenerator(const BasicScheduleGenerator&) = delete;
+    BasicScheduleGenerator& operator=(const BasicScheduleGenerator&) = delete;
+
+    // The next event; false once the run is over
+    bool Next(Event& event);
+    // Append up to count events to out; returns how many
+    size_t Take(size_t count, std::vector<Event>& out);
+
+    Iterator begin() { return Iterator(this); }
+    Iterator end() { return Iterator(); }
+
+    // Most timeline segments and completions the engine held at once
+    size_t MaxHeld() const { return m_maxHeld; }
+
+private:
+    void Refill();
+
+    Engine& m_engine;
+    Time m_step;
+    Time m_span;                    // Length of the next slice; grows while the CPU is idle
+    bool m_working = true;          // The engine still has work after the last slice
+    size_t m_position = 0;          // Next timeline segment to produce
+    std::vector<Index> m_completions;
+    size_t m_completion = 0;        // Next completion to produce
+    size_t m_maxHeld = 0;
+};
+
+typedef BasicScheduleGenerator<int, int> ScheduleGenerator;
@@ -0,0 +1,1626 @@
+#include "Scheduler.h"
+
+#include <algorithm>
+#include <climits>
+
+#include "BurstPredictor.h"
+#include "Checkpoint.h"
+#include "Metrics.h"
+#include "TickPacer.h"
+
+bool ReferenceTick(std::vector<Process>& processes, std::vector<ExecutionStep>& sequence) {
+    // Check if all processes are completed
+    bool allCompleted = std::all_of(processes.begin(), processes.end(),
+        [](const Process& p) { return p.completed; });
+
+    if (allCompleted) {
+        return false;
+    }
+
+    // Find process with shortest remaining time
+    auto shortestProcess = std::min_element(processes.begin(), processes.end(),
+        [](const Process& a, const Process& b) {
+            if (a.completed) return false;
+            if (b.completed) return true;
+            return a.remainingTime < b.remainingTime;
+        });
+
+    if (shortestProcess != processes.end() && !shortestProcess->completed) {
+        sequence.push_back({
+            static_cast<int>(shortestProcess - processes.begin()),
+            static_cast<int>(sequence.size())
+        });
+        // Execute process for one time unit
+        shortestProcess->remainingTime--;
+
+        // Update waiting times for other processes
+        for (auto& process : processes) {
+            if (!process.completed && &process != &(*shortestProcess)) {
+                process.waitingTime++;
+            }
+        }
+
+        // Check if process completed
+        if (shortestProcess->remainingTime == 0) {
+            shortestProcess->completed = true;
+            shortestProcess->turnaroundTime = shortestProcess->waitingTime + shortestProcess->burstTime;
+        }
+    }
+    return true;
+}
+
+void AppendSteps(const RunSegment& segment, std::vector<ExecutionStep>& sequence) {
+    for (int t = 0; t < segment.length; t++) {
+        sequence.push_back({ segment.processIndex, segment.startTime + t });
+    }
+}
+
+void CompressSteps(const std::vector<ExecutionStep>& sequence, std::vector<RunSegment>& segments) {
+    segments.clear();
+    for (const auto& step : sequence) {
+        if (!segments.empty() &&
+            segments.back().processIndex == step.processIndex &&
+            segments.back().startTime + segments.back().length == step.timeUnit) {
+            segments.back().length++;
+        }
+        else {
+            segments.push_back({ step.processIndex, step.timeUnit, 1 });
+        }
+    }
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Reset() {
+    m_processes.clear();
+    m_arrival.clear();
+    m_estimate.clear();
+    m_stamp.clear();
+    m_ready.clear();
+    m_waiting.clear();
+    m_pending.clear();
+    m_deadline.clear();
+    m_urgent.clear();
+    m_deadlines.clear();
+    m_checkedAt = 0;
+    m_admission.clear();
+    m_longest.clear();
+    m_deferred.clear();
+    m_deferredHead = 0;
+    m_outstanding = 0;
+    m_timeline.clear();
+    // Submissions posted before the reset belong to the old run
+    m_inbox.Drain(m_drained);
+    m_drained.clear();
+    m_stats = SchedulerStats();
+    m_completed = 0;
+    m_readyCount = 0;
+    m_running = NO_PROCESS;
+    m_protected = false;
+    m_lastRun = NO_PROCESS;
+    m_switchLeft = 0;
+    m_now = 0;
+    m_markAt = MAX_TIME;
+    m_marks = nullptr;
+    m_targets = nullptr;
+    m_admissions.clear();
+    m_admittedBefore = 0;
+    m_deadlinesFrom = 0;
+    m_logAdmissions = false;
+    // Devices stay configured; their queues belong to the old run
+    m_bursts.clear();
+    m_plans.clear();
+    for (auto& device : m_devices) {
+        device.queue.clear();
+        device.serving = NO_PROCESS;
+        device.doneAt = 0;
+    }
+    m_deviceStats.assign(m_devices.size(), DeviceStats());
+    m_ioSequence = 0;
+    m_blocked = 0;
+}
+
+template <typename Time, typename Index>
+Index BasicSrtnEngine<Time, Index>::Submit(const ProcessType& process, Time arrivalTime) {
+    Index index = static_cast<Index>(m_processes.size());
+    m_processes.push_back(process);
+    m_arrival.push_back(std::max(arrivalTime, m_now));
+    m_estimate.push_back(process.burstTime);
+    m_stamp.push_back(0);
+    m_admission.push_back(Admission::Waiting);
+    if (!m_deadline.empty()) {
+        m_deadline.push_back(NO_DEADLINE);
+    }
+    if (!m_plans.empty()) {
+        m_plans.push_back(IoPlan());
+    }
+
+    auto later = [this](Index a, Index b) { return ArrivesBefore(b, a); };
+    m_pending.push_back(index);
+    std::push_heap(m_pending.begin(), m_pending.end(), later);
+    return index;
+}
+
+template <typename Time, typename Index>
+Admission BasicSrtnEngine<Time, Index>::Offer(const ProcessType& process, Index& index, std::vector<Index>* shed) {
+    index = Submit(process, m_now);
+    m_shedLog = shed;
+    AdmitArrivals();
+    m_shedLog = nullptr;
+    return m_admission[index];
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::SetDeadline(Index index, Time deadline) {
+    if (m_deadline.empty()) {
+        m_deadline.assign(m_processes.size(), NO_DEADLINE);
+    }
+    m_deadline[index] = deadline;
+}
+
+template <typename Time, typename Index>
+Time BasicSrtnEngine<Time, Index>::Deadline(Index index) const {
+    return m_deadline.empty() ? NO_DEADLINE : m_deadline[index];
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::SetDevices(const std::vector<DeviceOptions>& devices) {
+    m_devices.clear();
+    for (const auto& options : devices) {
+        m_devices.push_back({ options.discipline, {}, NO_PROCESS, 0 });
+    }
+    m_deviceStats.assign(m_devices.size(), DeviceStats());
+}
+
+template <typename Time, typename Index>
+Index BasicSrtnEngine<Time, Index>::Submit(const ProcessType& process, Time arrivalTime,
+    const BasicBurst<Time>* bursts, size_t count) {
+    IoPlan plan = { static_cast<uint32_t>(m_bursts.size()), 0, 0, -1, 0 };
+    Time total = 0;
+    for (size_t i = 0; i < count; i++) {
+        BasicBurst<Time> burst = bursts[i];
+        burst.cpu = std::max<Time>(1, burst.cpu);
+        bool last = burst.device < 0 || static_cast<size_t>(burst.device) >= m_devices.size();
+        burst.device = last ? -1 : burst.device;
+        burst.io = last ? 0 : std::max<Time>(1, burst.io);
+        m_bursts.push_back(burst);
+        total += burst.cpu;
+        if (last) {
+            break;
+        }
+    }
+    plan.end = static_cast<uint32_t>(m_bursts.size());
+
+    ProcessType copy = process;
+    if (plan.end > plan.next) {
+        copy.burstTime = total;
+        copy.remainingTime = total;
+    }
+    // Without an I/O burst this is an ordinary process
+    if (plan.end == plan.next || (plan.end == plan.next + 1 && m_bursts.back().device < 0)) {
+        m_bursts.resize(plan.next);
+        return Submit(copy, arrivalTime);
+    }
+    Index index = Submit(copy, arrivalTime);
+    const BasicBurst<Time>& first = m_bursts[plan.next];
+    plan.cpuEnd = total - first.cpu;
+    m_estimate[index] = first.cpu;
+    if (m_plans.empty()) {
+        m_plans.resize(m_processes.size());
+    }
+    m_plans[index] = plan;
+    return index;
+}
+
+// Remaining time as far as the scheduler can tell. A process that outlives
+// its estimate is ranked as nearly done.
+template <typename Time, typename Index>
+Time BasicSrtnEngine<Time, Index>::Key(Index index) const {
+    const ProcessType& p = m_processes[index];
+    return std::max<Time>(0, m_estimate[index] - (p.burstTime - p.remainingTime));
+}
+
+// Rank of a process that has been ready since the given time; lower runs first
+template <typename Time, typename Index>
+long long BasicSrtnEngine<Time, Index>::Score(Index index, Time since) const {
+    DeadlineMode mode = m_options.deadlineMode;
+    if (mode == DeadlineMode::Edf || mode == DeadlineMode::LeastLaxity) {
+        // Processes without a deadline come after all that have one
+        const long long UNBOUNDED = 1LL << 62;
+        Time deadline = Deadline(index);
+        if (deadline == NO_DEADLINE) {
+            return UNBOUNDED + Key(index);
+        }
+        return mode == DeadlineMode::Edf ? deadline : static_cast<long long>(deadline) - Key(index);
+    }
+    if (m_options.agingPeriod <= 0) {
+        return Key(index);
+    }
+    return static_cast<long long>(Key(index)) * m_options.agingPeriod + since;
+}
+
+namespace {
+
+// Heap orders; ties go to the lowest index like the min_element comparator
+template <typename Entry>
+bool ScoredAfter(const Entry& a, const Entry& b) {
+    if (a.score != b.score) {
+        return a.score > b.score;
+    }
+    return a.index > b.index;
+}
+
+template <typename Entry>
+bool WaitedLess(const Entry& a, const Entry& b) {
+    if (a.since != b.since) {
+        return a.since > b.since;
+    }
+    return a.index > b.index;
+}
+
+template <typename Entry>
+bool StartsLater(const Entry& a, const Entry& b) {
+    if (a.latestStart != b.latestStart) {
+        return a.latestStart > b.latestStart;
+    }
+    return a.index > b.index;
+}
+
+template <typename Entry>
+bool LongerBefore(const Entry& a, const Entry& b) {
+    if (a.remaining != b.remaining) {
+        return a.remaining < b.remaining;
+    }
+    return a.index < b.index;
+}
+
+template <typename Entry>
+bool DueLater(const Entry& a, const Entry& b) {
+    return a.deadline > b.deadline;
+}
+
+template <typename Entry>
+bool IoAfter(const Entry& a, const Entry& b) {
+    if (a.key != b.key) {
+        return a.key > b.key;
+    }
+    return a.sequence > b.sequence;
+}
+
+} // namespace
+
+template <typename Time, typename Index>
+bool BasicSrtnEngine<Time, Index>::ArrivesBefore(Index a, Index b) const {
+    if (m_arrival[a] != m_arrival[b]) {
+        return m_arrival[a] < m_arrival[b];
+    }
+    return a < b;
+}
+
+template <typename Time, typename Index>
+Time BasicSrtnEngine<Time, Index>::NextArrival() const {
+    return m_pending.empty() ? -1 : m_arrival[m_pending.front()];
+}
+
+template <typename Time, typename Index>
+Time BasicSrtnEngine<Time, Index>::NextIo() const {
+    Time next = -1;
+    if (m_blocked == 0) {
+        return next;
+    }
+    for (const auto& device : m_devices) {
+        if (device.serving != NO_PROCESS && (next < 0 || device.doneAt < next)) {
+            next = device.doneAt;
+        }
+    }
+    return next;
+}
+
+template <typename Time, typename Index>
+typename BasicSrtnEngine<Time, Index>::IoPlan* BasicSrtnEngine<Time, Index>::PlanOf(Index index) {
+    // A plan always holds at least one burst, so end is 0 only for none
+    if (m_plans.empty() || m_plans[index].end == 0) {
+        return nullptr;
+    }
+    return &m_plans[index];
+}
+
+// remainingTime at which the current CPU burst is done; 0 for the last one
+template <typename Time, typename Index>
+Time BasicSrtnEngine<Time, Index>::CpuEnd(Index index) {
+    const IoPlan* plan = PlanOf(index);
+    return plan == nullptr ? 0 : plan->cpuEnd;
+}
+
+// Time spent blocked on devices so far, including any wait in progress
+template <typename Time, typename Index>
+Time BasicSrtnEngine<Time, Index>::IoTime(Index index) {
+    const IoPlan* plan = PlanOf(index);
+    if (plan == nullptr) {
+        return 0;
+    }
+    return plan->ioTime + (plan->blockedSince >= 0 ? m_now - plan->blockedSince : 0);
+}
+
+// The running process finished a CPU burst; queue its I/O request
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Block(Index index) {
+    IoPlan& plan = *PlanOf(index);
+    const BasicBurst<Time>& burst = m_bursts[plan.next];
+    size_t number = static_cast<size_t>(burst.device);
+    Device& device = m_devices[number];
+    plan.blockedSince = m_now;
+    m_blocked++;
+    m_stats.ioBlocks++;
+    MetricAdd(Counter::IoRequests);
+
+    uint64_t sequence = m_ioSequence++;
+    long long key = device.discipline == IoDiscipline::ShortestFirst ? static_cast<long long>(burst.io) :
+        static_cast<long long>(sequence);
+    device.queue.push_back({ key, sequence, index, burst.io, m_now });
+    std::push_heap(device.queue.begin(), device.queue.end(), IoAfter<IoRequest>);
+    if (device.serving == NO_PROCESS) {
+        StartIo(number, m_now);
+    }
+    else {
+        m_deviceStats[number].maxQueue = std::max(m_deviceStats[number].maxQueue, device.queue.size());
+    }
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::StartIo(size_t number, Time at) {
+    Device& device = m_devices[number];
+    std::pop_heap(device.queue.begin(), device.queue.end(), IoAfter<IoRequest>);
+    const IoRequest& request = device.queue.back();
+    device.serving = request.index;
+    device.doneAt = at + request.length;
+    m_deviceStats[number].queueTime += at - request.queuedAt;
+    m_deviceStats[number].busyTime += request.length;
+    device.queue.pop_back();
+}
+
+// The device's request is done: the process runs its next CPU burst, or
+// ends if that was its last burst
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::FinishIo(size_t number) {
+    Device& device = m_devices[number];
+    Index index = device.serving;
+    Time at = device.doneAt;
+    device.serving = NO_PROCESS;
+    m_deviceStats[number].requests++;
+    m_blocked--;
+
+    IoPlan& plan = *PlanOf(index);
+    plan.ioTime += at - plan.blockedSince;
+    plan.blockedSince = -1;
+    plan.next++;
+    if (plan.next == plan.end) {
+        Complete(index);
+    }
+    else {
+        const ProcessType& p = m_processes[index];
+        Time cpu = m_bursts[plan.next].cpu;
+        m_estimate[index] = p.burstTime - p.remainingTime + cpu;
+        plan.cpuEnd = p.remainingTime - cpu;
+        // Already admitted, so only shedding applies; see the class comment
+        size_t peak = m_stats.peakReady;
+        MakeReady(index);
+        if (m_options.admission == AdmissionPolicy::ShedLongest) {
+            ShedExcess();
+            m_stats.peakReady = std::max(peak, m_readyCount);
+        }
+    }
+    if (!device.queue.empty()) {
+        StartIo(number, at);
+    }
+}
+
+// Advance stops at every device completion, so they are handled on time
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::ProcessIo() {
+    if (m_blocked == 0) {
+        return;
+    }
+    for (size_t number = 0; number < m_devices.size(); number++) {
+        while (m_devices[number].serving != NO_PROCESS && m_devices[number].doneAt <= m_now) {
+            FinishIo(number);
+        }
+    }
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::DrainInbox() {
+    size_t drained = m_inbox.Drain(m_drained);
+    if (drained == 0) {
+        return;
+    }
+    MetricAdd(Counter::InboxPosts, drained);
+    for (const auto& process : m_drained) {
+        Submit(ProcessCast<Time>(process), m_now);
+    }
+    m_drained.clear();
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::MakeReady(Index index) {
+    uint32_t stamp = ++m_stamp[index];
+    m_ready.push_back({ Score(index, m_now), index, stamp });
+    std::push_heap(m_ready.begin(), m_ready.end(), ScoredAfter<ReadyEntry>);
+    if (m_options.maxWait > 0) {
+        m_waiting.push_back({ m_now, index, stamp });
+        std::push_heap(m_waiting.begin(), m_waiting.end(), WaitedLess<WaitEntry>);
+    }
+    if (m_options.deadlineMode == DeadlineMode::Slack && Deadline(index) != NO_DEADLINE) {
+        m_urgent.push_back({ Deadline(index) - Key(index), index, stamp });
+        std::push_heap(m_urgent.begin(), m_urgent.end(), StartsLater<UrgentEntry>);
+    }
+    m_readyCount++;
+    if (m_options.admission == AdmissionPolicy::ShedLongest) {
+        m_longest.push_back({ m_processes[index].remainingTime, index, stamp });
+        std::push_heap(m_longest.begin(), m_longest.end(), LongerBefore<LongestEntry>);
+        // Stale entries are only popped while shedding, so drop them once they
+        // outnumber the live ones. Each is dropped once: amortized O(1) a push.
+        if (m_longest.size() > 2 * m_readyCount) {
+            m_longest.erase(std::remove_if(m_longest.begin(), m_longest.end(),
+                [this](const LongestEntry& entry) { return entry.stamp != m_stamp[entry.index]; }), m_longest.end());
+            std::make_heap(m_longest.begin(), m_longest.end(), LongerBefore<LongestEntry>);
+        }
+    }
+    m_stats.peakReady = std::max(m_stats.peakReady, m_readyCount);
+}
+
+// Best ready process, or NO_PROCESS. Stale entries on top are discarded on the way.
+template <typename Time, typename Index>
+Index BasicSrtnEngine<Time, Index>::TopReady() {
+    while (!m_ready.empty()) {
+        const ReadyEntry& top = m_ready.front();
+        if (top.stamp == m_stamp[top.index]) {
+            return top.index;
+        }
+        std::pop_heap(m_ready.begin(), m_ready.end(), ScoredAfter<ReadyEntry>);
+        m_ready.pop_back();
+    }
+    return NO_PROCESS;
+}
+
+// Process that has been ready the longest, or NO_PROCESS
+template <typename Time, typename Index>
+Index BasicSrtnEngine<Time, Index>::OldestReady() {
+    while (!m_waiting.empty()) {
+        const WaitEntry& top = m_waiting.front();
+        if (top.stamp == m_stamp[top.index]) {
+            return top.index;
+        }
+        std::pop_heap(m_waiting.begin(), m_waiting.end(), WaitedLess<WaitEntry>);
+        m_waiting.pop_back();
+    }
+    return NO_PROCESS;
+}
+
+// Ready process whose slack runs out first, or NO_PROCESS
+template <typename Time, typename Index>
+Index BasicSrtnEngine<Time, Index>::MostUrgent() {
+    while (!m_urgent.empty()) {
+        const UrgentEntry& top = m_urgent.front();
+        if (top.stamp == m_stamp[top.index]) {
+            return top.index;
+        }
+        std::pop_heap(m_urgent.begin(), m_urgent.end(), StartsLater<UrgentEntry>);
+        m_urgent.pop_back();
+    }
+    return NO_PROCESS;
+}
+
+// Count every process still unfinished at a deadline the clock has passed,
+// or that finished after it
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::CheckDeadlines() {
+    m_checkedAt = m_now;
+    while (!m_deadlines.empty() && m_deadlines.front().deadline < m_now) {
+        std::pop_heap(m_deadlines.begin(), m_deadlines.end(), DueLater<DeadlineEntry>);
+        DeadlineEntry entry = m_deadlines.back();
+        m_deadlines.pop_back();
+        const ProcessType& p = m_processes[entry.index];
+        if (!p.completed || m_arrival[entry.index] + p.turnaroundTime > entry.deadline) {
+            m_stats.deadlineMisses++;
+            MetricAdd(Counter::DeadlineMisses);
+        }
+    }
+}
+
+// Leaves any copy in the other heaps stale
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::TakeReady(Index index) {
+    m_stamp[index]++;
+    m_readyCount--;
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::AdmitArrivals() {
+    auto later = [this](Index a, Index b) { return ArrivesBefore(b, a); };
+
+    while (!m_pending.empty() && m_arrival[m_pending.front()] <= m_now) {
+        std::pop_heap(m_pending.begin(), m_pending.end(), later);
+        Index index = m_pending.back();
+        m_pending.pop_back();
+        if (m_logAdmissions) {
+            m_admissions.push_back(index);
+            m_watchAdmitted = m_watchAdmitted || index == m_watch;
+        }
+        if (Deadline(index) != NO_DEADLINE) {
+            m_deadlines.push_back({ Deadline(index), index });
+            std::push_heap(m_deadlines.begin(), m_deadlines.end(), DueLater<DeadlineEntry>);
+        }
+
+        // The UI rejects empty bursts; treat any that slip in as done on arrival
+        if (m_processes[index].remainingTime <= 0) {
+            m_admission[index] = Admission::Admitted;
+            Complete(index);
+            continue;
+        }
+        // Processes with I/O are ranked by their known CPU bursts
+        if (m_predictor != nullptr && PlanOf(index) == nullptr) {
+            m_estimate[index] = m_predictor->Predict(m_processes[index].name);
+        }
+        Arrive(index);
+    }
+}
+
+// Whether one more ready process with this much work stays within the limits
+template <typename Time, typename Index>
+bool BasicSrtnEngine<Time, Index>::Fits(Time work) const {
+    if (m_running == NO_PROCESS && m_readyCount == 0) {
+        return true;
+    }
+    if (m_options.maxReady > 0 && Occupancy() + 1 > static_cast<size_t>(m_options.maxReady)) {
+        return false;
+    }
+    return m_options.maxOutstanding <= 0 || m_outstanding + work <= m_options.maxOutstanding;
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Arrive(Index index) {
+    Time work = m_processes[index].remainingTime;
+    switch (m_options.admission) {
+    case AdmissionPolicy::Defer:
+        // Behind earlier deferrals even if it would fit, so they keep their order
+        if (DeferredCount() > 0 || !Fits(work)) {
+            m_deferred.push_back(index);
+            m_admission[index] = Admission::Deferred;
+            m_stats.deferred++;
+            MetricAdd(Counter::AdmissionDeferrals);
+            return;
+        }
+        break;
+    case AdmissionPolicy::Reject:
+        if (!Fits(work)) {
+            m_admission[index] = Admission::Rejected;
+            m_stats.rejected++;
+            m_stats.rejectedWork += work;
+            MetricAdd(Counter::AdmissionRejects);
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    size_t peak = m_stats.peakReady;
+    Admit(index);
+    if (m_options.admission == AdmissionPolicy::ShedLongest) {
+        ShedExcess();
+        // The ready set is only as large as what survives the shedding
+        m_stats.peakReady = std::max(peak, m_readyCount);
+    }
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Admit(Index index) {
+    m_admission[index] = Admission::Admitted;
+    m_outstanding += m_processes[index].burstTime;
+    m_stats.admitted++;
+    m_stats.admittedWork += m_processes[index].burstTime;
+    MakeReady(index);
+    MetricAdd(Counter::Arrivals);
+}
+
+// Called at each decision point: deferred processes go in, oldest first, as
+// completions make room
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::AdmitDeferred() {
+    while (DeferredCount() > 0 && Fits(m_processes[m_deferred[m_deferredHead]].remainingTime)) {
+        Admit(m_deferred[m_deferredHead++]);
+    }
+    // Drop the admitted prefix once it is most of the queue, so popping stays amortized O(1)
+    if (m_deferredHead == m_deferred.size()) {
+        m_deferred.clear();
+        m_deferredHead = 0;
+    }
+    else if (m_deferredHead * 2 > m_deferred.size()) {
+        m_deferred.erase(m_deferred.begin(), m_deferred.begin() + m_deferredHead);
+        m_deferredHead = 0;
+    }
+}
+
+// Drop the ready processes with the most work left until within the limits;
+// the running process is never shed
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::ShedExcess() {
+    auto over = [this]() {
+        return (m_options.maxReady > 0 && Occupancy() > static_cast<size_t>(m_options.maxReady)) ||
+            (m_options.maxOutstanding > 0 && m_outstanding > m_options.maxOutstanding);
+    };
+    while (over() && !m_longest.empty()) {
+        std::pop_heap(m_longest.begin(), m_longest.end(), LongerBefore<LongestEntry>);
+        LongestEntry entry = m_longest.back();
+        m_longest.pop_back();
+        if (entry.stamp != m_stamp[entry.index]) {
+            continue;
+        }
+        TakeReady(entry.index);
+        ProcessType& p = m_processes[entry.index];
+        m_admission[entry.index] = Admission::Shed;
+        if (m_shedLog != nullptr) {
+            m_shedLog->push_back(entry.index);
+        }
+        m_outstanding -= p.burstTime;
+        m_stats.shed++;
+        m_stats.shedWork += p.remainingTime;
+        MetricAdd(Counter::AdmissionSheds);
+        p.waitingTime = m_now - m_arrival[entry.index] - (p.burstTime - p.remainingTime);
+        p.turnaroundTime = 0;
+    }
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Dispatch() {
+    if (m_readyCount == 0 || (m_running != NO_PROCESS && m_protected)) {
+        return;
+    }
+    MetricAdd(Counter::Decisions);
+    MetricObserve(Histogram::ReadyDepth, m_readyCount);
+
+    Index overdue = m_options.maxWait > 0 ? OldestReady() : NO_PROCESS;
+    bool forced = overdue != NO_PROCESS && m_now - m_waiting.front().since >= m_options.maxWait;
+    Index candidate = overdue;
+    // Out of slack, unless the running process would run out first
+    Index urgent = !forced && m_options.deadlineMode == DeadlineMode::Slack ? MostUrgent() : NO_PROCESS;
+    bool overriding = urgent != NO_PROCESS && m_urgent.front().latestStart - m_now <= m_options.slackThreshold &&
+        (m_running == NO_PROCESS || Deadline(m_running) == NO_DEADLINE ||
+         Deadline(m_running) - Key(m_running) > m_urgent.front().latestStart);
+    if (forced) {
+        std::pop_heap(m_waiting.begin(), m_waiting.end(), WaitedLess<WaitEntry>);
+        m_waiting.pop_back();
+    }
+    else if (overriding) {
+        candidate = urgent;
+        std::pop_heap(m_urgent.begin(), m_urgent.end(), StartsLater<UrgentEntry>);
+        m_urgent.pop_back();
+    }
+    else {
+        candidate = TopReady();
+        if (m_running != NO_PROCESS) {
+            // Under aging a process wins on the credit it earned waiting and
+            // loses it once it runs. Judged again when its switch ends, before
+            // it has run, it would lose that credit, be preempted and win it
+            // back, forever. It keeps the CPU until it has run.
+            if (m_options.agingPeriod > 0 && m_lastRun != m_running) {
+                return;
+            }
+            // The running process is not waiting, so it is scored as of now
+            long long running = Score(m_running, m_now);
+            long long score = m_ready.front().score;
+            if (score > running || (score == running && candidate > m_running)) {
+                return;
+            }
+            bool aged = m_options.deadlineMode == DeadlineMode::None || m_options.deadlineMode == DeadlineMode::Slack;
+            long long gain = (running - score) / (aged ? std::max(1, m_options.agingPeriod) : 1);
+            if (gain <= m_options.preemptThreshold) {
+                return;
+            }
+        }
+        std::pop_heap(m_ready.begin(), m_ready.end(), ScoredAfter<ReadyEntry>);
+        m_ready.pop_back();
+    }
+    TakeReady(candidate);
+
+    if (m_running != NO_PROCESS) {
+        MakeReady(m_running);
+        m_stats.preemptions++;
+        MetricAdd(Counter::Preemptions);
+    }
+    MetricAdd(Counter::Dispatches);
+    m_running = candidate;
+    m_protected = forced || overriding;
+    if (forced) {
+        m_stats.forced++;
+        MetricAdd(Counter::ForcedDispatches);
+    }
+    if (overriding) {
+        m_stats.slackOverrides++;
+        MetricAdd(Counter::SlackOverrides);
+    }
+
+    if (m_lastRun != NO_PROCESS && m_lastRun != candidate) {
+        m_stats.switches++;
+        MetricAdd(Counter::Switches);
+        m_switchLeft = m_options.switchCost;
+    }
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Record(Index processIndex, Time length) {
+    if (!m_timeline.empty() &&
+        m_timeline.back().processIndex == processIndex &&
+        m_timeline.back().startTime + m_timeline.back().length == m_now) {
+        m_timeline.back().length += length;
+    }
+    else {
+        m_timeline.push_back({ processIndex, m_now, length });
+    }
+    m_now += length;
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Execute(Time length) {
+    if (m_switchLeft > 0) {
+        // Context switches share the NO_PROCESS index (CONTEXT_SWITCH_INDEX)
+        Record(NO_PROCESS, length);
+        m_switchLeft -= length;
+        m_stats.switchTime += length;
+        return;
+    }
+    Record(m_running, length);
+    m_lastRun = m_running;
+    m_stats.busyTime += length;
+    m_processes[m_running].remainingTime -= length;
+    if (m_processes[m_running].remainingTime == CpuEnd(m_running)) {
+        const IoPlan* plan = PlanOf(m_running);
+        if (plan != nullptr && m_bursts[plan->next].device >= 0) {
+            Block(m_running);
+        }
+        else {
+            Complete(m_running);
+        }
+        m_running = NO_PROCESS;
+        m_protected = false;
+    }
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Complete(Index index) {
+    ProcessType& p = m_processes[index];
+    p.completed = true;
+    m_completed++;
+    if (m_completionLog != nullptr) {
+        m_completionLog->push_back(index);
+    }
+    m_outstanding -= p.burstTime;
+    MetricAdd(Counter::Completions);
+    p.turnaroundTime = m_now - m_arrival[index];
+    p.waitingTime = p.turnaroundTime - p.burstTime;
+    if (PlanOf(index) != nullptr) {
+        p.waitingTime -= IoTime(index);
+        m_plans[index] = IoPlan();
+        return;
+    }
+    if (m_predictor != nullptr) {
+        m_predictor->Observe(p.name, static_cast<int>(std::min<Time>(p.burstTime, INT_MAX)));
+    }
+}
+
+template <typename Time, typename Index>
+bool BasicSrtnEngine<Time, Index>::HasWork() const {
+    return m_running != NO_PROCESS || m_readyCount > 0 || !m_pending.empty() || !m_inbox.Empty() ||
+        m_blocked > 0 || DeferredCount() > 0;
+}
+
+// Runs until the clock reaches horizon or there is nothing left to run
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Advance(Time horizon) {
+    while (m_now < horizon) {
+        if (m_now >= m_markAt && AtMark()) {
+            return;
+        }
+        DrainInbox();
+        ProcessIo();
+        AdmitDeferred();
+        AdmitArrivals();
+        CheckDeadlines();
+        if (m_switchLeft == 0) {
+            Dispatch();
+        }
+
+        Time nextArrival = NextArrival();
+        Time nextIo = NextIo();
+        if (m_running == NO_PROCESS) {
+            Time next = nextIo < 0 || (nextArrival >= 0 && nextArrival < nextIo) ? nextArrival : nextIo;
+            if (next < 0) {
+                return;
+            }
+            if (!m_deadlines.empty()) {
+                next = static_cast<Time>(std::min<long long>(next, static_cast<long long>(m_deadlines.front().deadline) + 1));
+            }
+            m_now = std::min(horizon, next);
+            continue;
+        }
+
+        // Run until the next decision point: end of switch, end of the CPU
+        // burst, arrival, I/O completion, a ready process reaching maxWait,
+        // a deadline passing, or the horizon
+        Time left = m_switchLeft > 0 ? m_switchLeft : m_processes[m_running].remainingTime - CpuEnd(m_running);
+        Time until = m_now + std::min<Time>(left, horizon - m_now);
+        // Arrivals are admitted on time even during a switch: aging and
+        // maxWait rank them by when they became ready
+        if (nextArrival >= 0) {
+            until = std::min(until, nextArrival);
+        }
+        if (nextIo >= 0) {
+            until = std::min(until, nextIo);
+        }
+        if (!m_deadlines.empty()) {
+            until = static_cast<Time>(std::min<long long>(until, static_cast<long long>(m_deadlines.front().deadline) + 1));
+        }
+        if (m_options.maxWait > 0 && m_switchLeft == 0 && !m_protected && OldestReady() != NO_PROCESS) {
+            long long due = static_cast<long long>(m_waiting.front().since) + m_options.maxWait;
+            if (due > m_now) {
+                until = static_cast<Time>(std::min<long long>(until, due));
+            }
+        }
+        // Under aging the running process is first judged once it has run.
+        // From then its score falls while its estimate lasts and grows with
+        // the clock after that, so decide again when it first could lose,
+        // not wherever the caller's horizon happens to fall
+        if (m_options.agingPeriod > 0 && m_switchLeft == 0 && !m_protected && TopReady() != NO_PROCESS) {
+            bool aged = m_options.deadlineMode == DeadlineMode::None || m_options.deadlineMode == DeadlineMode::Slack;
+            long long due = static_cast<long long>(m_now) + 1;
+            if (m_lastRun == m_running) {
+                due = aged ? std::max<long long>(due + Key(m_running) - 1, m_ready.front().score +
+                    (static_cast<long long>(m_options.preemptThreshold) + 1) * m_options.agingPeriod) : MAX_TIME;
+            }
+            until = static_cast<Time>(std::min<long long>(until, due));
+        }
+        if (m_options.deadlineMode == DeadlineMode::Slack && m_switchLeft == 0 && !m_protected &&
+            MostUrgent() != NO_PROCESS) {
+            long long due = static_cast<long long>(m_urgent.front().latestStart) - m_options.slackThreshold;
+            if (due > m_now) {
+                until = static_cast<Time>(std::min<long long>(until, due));
+            }
+        }
+        // Under least laxity the running process's score grows by one per
+        // unit run; decide again when it would lose to the best ready one
+        if (m_options.deadlineMode == DeadlineMode::LeastLaxity && m_switchLeft == 0 &&
+            Deadline(m_running) != NO_DEADLINE && TopReady() != NO_PROCESS &&
+            Deadline(m_ready.front().index) != NO_DEADLINE) {
+            long long due = static_cast<long long>(m_now) + m_ready.front().score + m_options.preemptThreshold -
+                Score(m_running, m_now) + 1;
+            if (due > m_now) {
+                until = static_cast<Time>(std::min<long long>(until, due));
+            }
+        }
+        Execute(until - m_now);
+    }
+}
+
+template <typename Time, typename Index>
+bool BasicSrtnEngine<Time, Index>::RunUntil(Time time) {
+    Advance(time);
+    // Nothing left to run; idle time still passes
+    m_now = std::max(m_now, time);
+    DrainInbox();
+    ProcessIo();
+    AdmitDeferred();
+    AdmitArrivals();
+    CheckDeadlines();
+    return HasWork();
+}
+
+template <typename Time, typename Index>
+bool BasicSrtnEngine<Time, Index>::RunBusyUntil(Time time) {
+    Advance(time);
+    return HasWork() && RunUntil(time);
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::RunToCompletion() {
+    Advance(MAX_TIME);
+}
+
+template <typename Time, typename Index>
+bool BasicSrtnEngine<Time, Index>::RunPaced(TickPacer& pacer) {
+    long long due = std::min<long long>(pacer.DueTick(), MAX_TIME - 1);
+    if (due <= m_now) {
+        return HasWork();
+    }
+    bool working = RunUntil(static_cast<Time>(due));
+    pacer.Reached(due);
+    return working;
+}
+
+template <typename Time, typename Index>
+const std::vector<BasicProcess<Time>>& BasicSrtnEngine<Time, Index>::Processes() {
+    // Completed processes were finalized in Complete(); the rest are live.
+    // A process has waited for every unit since arrival it did not run.
+    for (size_t i = 0; i < m_processes.size(); i++) {
+        ProcessType& p = m_processes[i];
+        if (p.completed || m_admission[i] == Admission::Rejected || m_admission[i] == Admission::Shed) {
+            continue;
+        }
+        Time present = std::max<Time>(0, m_now - m_arrival[i]);
+        p.waitingTime = present - (p.burstTime - p.remainingTime) - IoTime(static_cast<Index>(i));
+        p.turnaroundTime = 0;
+    }
+    return m_processes;
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::TrimTimeline() {
+    if (m_timeline.size() > 1) {
+        m_timeline.erase(m_timeline.begin(), m_timeline.end() - 1);
+    }
+}
+
+template <typename Time, typename Index>
+size_t BasicSrtnEngine<Time, Index>::MemoryUsage() const {
+    return m_processes.capacity() * sizeof(ProcessType) +
+        (m_arrival.capacity() + m_estimate.capacity()) * sizeof(Time) +
+        m_stamp.capacity() * sizeof(uint32_t) +
+        m_ready.capacity() * sizeof(ReadyEntry) +
+        m_waiting.capacity() * sizeof(WaitEntry) +
+        m_pending.capacity() * sizeof(Index) +
+        m_deadline.capacity() * sizeof(Time) +
+        m_admission.capacity() * sizeof(Admission) +
+        m_longest.capacity() * sizeof(LongestEntry) +
+        m_deferred.capacity() * sizeof(Index) +
+        m_urgent.capacity() * sizeof(UrgentEntry) +
+        m_deadlines.capacity() * sizeof(DeadlineEntry) +
+        m_timeline.capacity() * sizeof(Segment) +
+        m_bursts.capacity() * sizeof(BasicBurst<Time>) +
+        m_plans.capacity() * sizeof(IoPlan);
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::SaveState(std::vector<unsigned char>& out) {
+    DrainInbox();
+    out.clear();
+    ByteWriter writer(out);
+    WriteCheckpointHeader(writer, sizeof(Time), sizeof(Index));
+
+    writer.Put(m_options.switchCost);
+    writer.Put(m_options.preemptThreshold);
+    writer.Put(m_options.agingPeriod);
+    writer.Put(m_options.maxWait);
+    writer.Put<uint8_t>(static_cast<uint8_t>(m_options.deadlineMode));
+    writer.Put(m_options.slackThreshold);
+    writer.Put<uint8_t>(static_cast<uint8_t>(m_options.admission));
+    writer.Put(m_options.maxReady);
+    writer.Put(m_options.maxOutstanding);
+    writer.Put(m_stats.switches);
+    writer.Put(m_stats.preemptions);
+    writer.Put(m_stats.switchTime);
+    writer.Put(m_stats.busyTime);
+    writer.Put(m_stats.forced);
+    writer.Put(m_stats.deadlineMisses);
+    writer.Put(m_stats.slackOverrides);
+    writer.Put(m_stats.admitted);
+    writer.Put(m_stats.deferred);
+    writer.Put(m_stats.rejected);
+    writer.Put(m_stats.shed);
+    writer.Put(m_stats.admittedWork);
+    writer.Put(m_stats.rejectedWork);
+    writer.Put(m_stats.shedWork);
+    writer.Put<uint64_t>(m_stats.peakReady);
+    writer.Put(m_outstanding);
+
+    writer.Put(m_now);
+    writer.Put(m_running);
+    writer.Put(m_lastRun);
+    writer.Put<uint8_t>(m_protected ? 1 : 0);
+    writer.Put(m_switchLeft);
+    writer.Put<uint64_t>(m_completed);
+    writer.Put<uint64_t>(m_readyCount);
+
+    writer.Put<uint64_t>(m_processes.size());
+    for (const auto& p : m_processes) {
+        writer.PutName(p.name);
+        writer.Put(p.burstTime);
+        writer.Put(p.remainingTime);
+        writer.Put(p.appearingTime);
+        writer.Put(p.waitingTime);
+        writer.Put(p.turnaroundTime);
+        writer.Put<uint8_t>(p.completed ? 1 : 0);
+    }
+    writer.PutArray(m_arrival);
+    writer.PutArray(m_estimate);
+    writer.PutArray(m_stamp);
+    writer.PutArray(m_pending);
+    writer.PutArray(m_deadline);
+    writer.PutArray(m_admission);
+    writer.Put<uint64_t>(DeferredCount());
+    for (size_t i = m_deferredHead; i < m_deferred.size(); i++) {
+        writer.Put(m_deferred[i]);
+    }
+
+    // Heaps are written in their array order, so ties break the same way after a load
+    writer.Put<uint64_t>(m_ready.size());
+    for (const auto& entry : m_ready) {
+        writer.Put(entry.score);
+        writer.Put(entry.index);
+        writer.Put(entry.stamp);
+    }
+    writer.Put<uint64_t>(m_waiting.size());
+    for (const auto& entry : m_waiting) {
+        writer.Put(entry.since);
+        writer.Put(entry.index);
+        writer.Put(entry.stamp);
+    }
+    writer.Put<uint64_t>(m_urgent.size());
+    for (const auto& entry : m_urgent) {
+        writer.Put(entry.latestStart);
+        writer.Put(entry.index);
+        writer.Put(entry.stamp);
+    }
+    writer.Put<uint64_t>(m_deadlines.size());
+    for (const auto& entry : m_deadlines) {
+        writer.Put(entry.deadline);
+        writer.Put(entry.index);
+    }
+    writer.Put<uint64_t>(m_longest.size());
+    for (const auto& entry : m_longest) {
+        writer.Put(entry.remaining);
+        writer.Put(entry.index);
+        writer.Put(entry.stamp);
+    }
+    writer.Put<uint64_t>(m_timeline.size());
+    for (const auto& segment : m_timeline) {
+        writer.Put(segment.processIndex);
+        writer.Put(segment.startTime);
+        writer.Put(segment.length);
+    }
+
+    // I/O: every burst list, the plans of unfinished processes by index, and
+    // each device's queue
+    writer.Put<uint64_t>(m_bursts.size());
+    for (const auto& burst : m_bursts) {
+        writer.Put(burst.cpu);
+        writer.Put<int32_t>(burst.device);
+        writer.Put(burst.io);
+    }
+    std::vector<Index> planned;
+    for (size_t i = 0; i < m_plans.size(); i++) {
+        if (m_plans[i].end > 0) {
+            planned.push_back(static_cast<Index>(i));
+        }
+    }
+    writer.Put<uint64_t>(planned.size());
+    for (Index index : planned) {
+        const IoPlan& plan = m_plans[index];
+        writer.Put(index);
+        writer.Put(plan.next);
+        writer.Put(plan.end);
+        writer.Put(plan.cpuEnd);
+        writer.Put(plan.blockedSince);
+        writer.Put(plan.ioTime);
+    }
+    writer.Put<uint64_t>(m_devices.size());
+    for (size_t i = 0; i < m_devices.size(); i++) {
+        const Device& device = m_devices[i];
+        writer.Put<uint8_t>(static_cast<uint8_t>(device.discipline));
+        writer.Put(device.serving);
+        writer.Put(device.doneAt);
+        writer.Put<uint64_t>(device.queue.size());
+        for (const auto& request : device.queue) {
+            writer.Put(request.key);
+            writer.Put(request.sequence);
+            writer.Put(request.index);
+            writer.Put(request.length);
+            writer.Put(request.queuedAt);
+        }
+        const DeviceStats& stats = m_deviceStats[i];
+        writer.Put(stats.requests);
+        writer.Put(stats.busyTime);
+        writer.Put(stats.queueTime);
+        writer.Put<uint64_t>(stats.maxQueue);
+    }
+    writer.Put(m_ioSequence);
+    writer.Put<uint64_t>(m_blocked);
+
+    writer.Put<uint8_t>(m_predictor != nullptr ? 1 : 0);
+    if (m_predictor != nullptr) {
+        m_predictor->Save(writer);
+    }
+}
+
+template <typename Time, typename Index>
+bool BasicSrtnEngine<Time, Index>::LoadState(const std::vector<unsigned char>& in, std::string& error) {
+    Reset();
+    ByteReader reader(in.data(), in.size());
+    size_t timeBytes = 0;
+    size_t indexBytes = 0;
+    if (!ReadCheckpointHeader(reader, timeBytes, indexBytes, error)) {
+        return false;
+    }
+    if (timeBytes != sizeof(Time) || indexBytes != sizeof(Index)) {
+        error = "checkpoint has " + std::to_string(timeBytes * 8) + "-bit time and " +
+            std::to_string(indexBytes * 8) + "-bit indices";
+        return false;
+    }
+
+    reader.Get(m_options.switchCost);
+    reader.Get(m_options.preemptThreshold);
+    reader.Get(m_options.agingPeriod);
+    reader.Get(m_options.maxWait);
+    uint8_t mode = 0;
+    reader.Get(mode);
+    m_options.deadlineMode = static_cast<DeadlineMode>(mode);
+    reader.Get(m_options.slackThreshold);
+    uint8_t policy = 0;
+    reader.Get(policy);
+    m_options.admission = static_cast<AdmissionPolicy>(policy);
+    reader.Get(m_options.maxReady);
+    reader.Get(m_options.maxOutstanding);
+    reader.Get(m_stats.switches);
+    reader.Get(m_stats.preemptions);
+    reader.Get(m_stats.switchTime);
+    reader.Get(m_stats.busyTime);
+    reader.Get(m_stats.forced);
+    reader.Get(m_stats.deadlineMisses);
+    reader.Get(m_stats.slackOverrides);
+    reader.Get(m_stats.admitted);
+    reader.Get(m_stats.deferred);
+    reader.Get(m_stats.rejected);
+    reader.Get(m_stats.shed);
+    reader.Get(m_stats.admittedWork);
+    reader.Get(m_stats.rejectedWork);
+    reader.Get(m_stats.shedWork);
+    uint64_t peak = 0;
+    reader.Get(peak);
+    m_stats.peakReady = static_cast<size_t>(peak);
+    reader.Get(m_outstanding);
+
+    uint8_t flag = 0;
+    uint64_t count = 0;
+    reader.Get(m_now);
+    reader.Get(m_running);
+    reader.Get(m_lastRun);
+    reader.Get(flag);
+    m_protected = flag != 0;
+    reader.Get(m_switchLeft);
+    reader.Get(count);
+    m_completed = static_cast<size_t>(count);
+    reader.Get(count);
+    m_readyCount = static_cast<size_t>(count);
+
+    uint64_t processes = 0;
+    reader.Get(processes);
+    for (uint64_t i = 0; i < processes && reader.Ok(); i++) {
+        ProcessType p = {};
+        reader.GetName(p.name);
+        reader.Get(p.burstTime);
+        reader.Get(p.remainingTime);
+        reader.Get(p.appearingTime);
+        reader.Get(p.waitingTime);
+        reader.Get(p.turnaroundTime);
+        reader.Get(flag);
+        p.completed = flag != 0;
+        m_processes.push_back(p);
+    }
+    reader.GetArray(m_arrival);
+    reader.GetArray(m_estimate);
+    reader.GetArray(m_stamp);
+    reader.GetArray(m_pending);
+    reader.GetArray(m_deadline);
+    reader.GetArray(m_admission);
+    reader.Get(count);
+    for (uint64_t i = 0; i < count && reader.Ok(); i++) {
+        Index index = 0;
+        reader.Get(index);
+        m_deferred.push_back(index);
+    }
+
+    reader.Get(count);
+    for (uint64_t i = 0; i < count && reader.Ok(); i++) {
+        ReadyEntry entry = {};
+        reader.Get(entry.score);
+        reader.Get(entry.index);
+        reader.Get(entry.stamp);
+        m_ready.push_back(entry);
+    }
+    reader.Get(count);
+    for (uint64_t i = 0; i < count && reader.Ok(); i++) {
+        WaitEntry entry = {};
+        reader.Get(entry.since);
+        reader.Get(entry.index);
+        reader.Get(entry.stamp);
+        m_waiting.push_back(entry);
+    }
+    reader.Get(count);
+    for (uint64_t i = 0; i < count && reader.Ok(); i++) {
+        UrgentEntry entry = {};
+        reader.Get(entry.latestStart);
+        reader.Get(entry.index);
+        reader.Get(entry.stamp);
+        m_urgent.push_back(entry);
+    }
+    reader.Get(count);
+    for (uint64_t i = 0; i < count && reader.Ok(); i++) {
+        DeadlineEntry entry = {};
+        reader.Get(entry.deadline);
+        reader.Get(entry.index);
+        m_deadlines.push_back(entry);
+    }
+    reader.Get(count);
+    for (uint64_t i = 0; i < count && reader.Ok(); i++) {
+        LongestEntry entry = {};
+        reader.Get(entry.remaining);
+        reader.Get(entry.index);
+        reader.Get(entry.stamp);
+        m_longest.push_back(entry);
+    }
+    reader.Get(count);
+    for (uint64_t i = 0; i < count && reader.Ok(); i++) {
+        Segment segment = {};
+        reader.Get(segment.processIndex);
+        reader.Get(segment.startTime);
+        reader.Get(segment.length);
+        m_timeline.push_back(segment);
+    }
+
+    reader.Get(count);
+    for (uint64_t i = 0; i < count && reader.Ok(); i++) {
+        BasicBurst<Time> burst = {};
+        int32_t device = 0;
+        reader.Get(burst.cpu);
+        reader.Get(device);
+        reader.Get(burst.io);
+        burst.device = device;
+        m_bursts.push_back(burst);
+    }
+    bool plansValid = true;
+    reader.Get(count);
+    for (uint64_t i = 0; i < count && reader.Ok(); i++) {
+        Index index = 0;
+        IoPlan plan = {};
+        reader.Get(index);
+        reader.Get(plan.next);
+        reader.Get(plan.end);
+        reader.Get(plan.cpuEnd);
+        reader.Get(plan.blockedSince);
+        reader.Get(plan.ioTime);
+        plansValid = plansValid && plan.next < plan.end && plan.end <= m_bursts.size() &&
+            static_cast<size_t>(index) < m_processes.size();
+        if (plansValid) {
+            m_plans.resize(m_processes.size());
+            m_plans[index] = plan;
+        }
+    }
+    // The checkpoint's devices replace the configured ones
+    m_devices.clear();
+    m_deviceStats.clear();
+    reader.Get(count);
+    for (uint64_t i = 0; i < count && reader.Ok(); i++) {
+        uint8_t discipline = 0;
+        Device device = {};
+        reader.Get(discipline);
+        device.discipline = static_cast<IoDiscipline>(discipline);
+        plansValid = plansValid && discipline <= 1;
+        reader.Get(device.serving);
+        reader.Get(device.doneAt);
+        uint64_t queued = 0;
+        reader.Get(queued);
+        for (uint64_t j = 0; j < queued && reader.Ok(); j++) {
+            IoRequest request = {};
+            reader.Get(request.key);
+            reader.Get(request.sequence);
+            reader.Get(request.index);
+            reader.Get(request.length);
+            reader.Get(request.queuedAt);
+            device.queue.push_back(request);
+        }
+        DeviceStats stats;
+        uint64_t maxQueue = 0;
+        reader.Get(stats.requests);
+        reader.Get(stats.busyTime);
+        reader.Get(stats.queueTime);
+        reader.Get(maxQueue);
+        stats.maxQueue = static_cast<size_t>(maxQueue);
+        m_devices.push_back(device);
+        m_deviceStats.push_back(stats);
+    }
+    reader.Get(m_ioSequence);
+    reader.Get(count);
+    m_blocked = static_cast<size_t>(count);
+
+    reader.Get(flag);
+    if (reader.Ok() && flag != 0) {
+        if (m_predictor == nullptr) {
+            error = "checkpoint was taken with a burst predictor";
+            Reset();
+            return false;
+        }
+        m_predictor->Load(reader);
+    }
+
+    // Every index must name a process; anything else is a damaged file
+    size_t n = m_processes.size();
+    bool valid = reader.Ok() && reader.AtEnd() && m_arrival.size() == n && m_estimate.size() == n &&
+        m_stamp.size() == n && (m_deadline.empty() || m_deadline.size() == n) && mode <= 3 &&
+        m_admission.size() == n && policy <= 3 && (m_running == NO_PROCESS || static_cast<size_t>(m_running) < n) &&
+        (m_lastRun == NO_PROCESS || static_cast<size_t>(m_lastRun) < n);
+    for (Index index : m_pending) {
+        valid = valid && static_cast<size_t>(index) < n;
+    }
+    for (const auto& entry : m_ready) {
+        valid = valid && static_cast<size_t>(entry.index) < n;
+    }
+    for (const auto& entry : m_waiting) {
+        valid = valid && static_cast<size_t>(entry.index) < n;
+    }
+    for (const auto& entry : m_urgent) {
+        valid = valid && static_cast<size_t>(entry.index) < n;
+    }
+    for (const auto& entry : m_deadlines) {
+        valid = valid && static_cast<size_t>(entry.index) < n;
+    }
+    for (const auto& entry : m_longest) {
+        valid = valid && static_cast<size_t>(entry.index) < n;
+    }
+    for (Index index : m_deferred) {
+        valid = valid && static_cast<size_t>(index) < n;
+    }
+    for (Admission admission : m_admission) {
+        valid = valid && admission <= Admission::Shed;
+    }
+    valid = valid && plansValid;
+    for (const auto& device : m_devices) {
+        valid = valid && (device.serving == NO_PROCESS || static_cast<size_t>(device.serving) < n);
+        for (const auto& request : device.queue) {
+            valid = valid && static_cast<size_t>(request.index) < n;
+        }
+    }
+    if (!valid) {
+        error = "damaged checkpoint";
+        Reset();
+        return false;
+    }
+    return true;
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::RecordMarks(std::vector<Mark>* marks, Time every) {
+    m_marks = marks;
+    if (marks == nullptr) {
+        m_markAt = MAX_TIME;
+        m_logAdmissions = false;
+        return;
+    }
+    m_markEvery = std::max<Time>(1, every);
+    m_markAt = m_now;
+    m_admissions.clear();
+    m_admittedBefore = 0;
+    m_deadlinesFrom = 0;
+    m_logAdmissions = true;
+}
+
+// Called by Advance at an event boundary; true stops the run at a match
+template <typename Time, typename Index>
+bool BasicSrtnEngine<Time, Index>::AtMark() {
+    if (m_marks != nullptr) {
+        // A mark holds the running and ready processes, so under load marks
+        // are spaced by work as well as time: the next waits until as many
+        // admissions and completions as the last one holds. All marks
+        // together then hold O(processes) entries.
+        size_t done = m_completed + m_admissions.size();
+        if (m_marks->empty() ||
+            done - m_marks->back().completed - m_marks->back().admitted >= m_marks->back().active.size()) {
+            TakeMark();
+        }
+        m_markAt = m_now > MAX_TIME - m_markEvery ? MAX_TIME : m_now - m_now % m_markEvery + m_markEvery;
+        return false;
+    }
+    const std::vector<Mark>& marks = *m_targets;
+    while (m_target < marks.size() && marks[m_target].now < m_now) {
+        m_target++;
+    }
+    if (m_target < marks.size() && marks[m_target].now == m_now) {
+        if (m_watchAdmitted && Matches(marks[m_target])) {
+            m_matched = m_target;
+            return true;
+        }
+        m_target++;
+    }
+    m_markAt = m_target < marks.size() ? marks[m_target].now : MAX_TIME;
+    return false;
+}
+
+// Live heap entries in heap order: sorted arrays are valid heaps, and the
+// same ready set always collects to the same arrays
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::CollectReady(std::vector<ReadyEntry>& ready, std::vector<WaitEntry>& waiting) const {
+    ready.clear();
+    waiting.clear();
+    for (const auto& entry : m_ready) {
+        if (entry.stamp == m_stamp[entry.index]) {
+            ready.push_back(entry);
+        }
+    }
+    for (const auto& entry : m_waiting) {
+        if (entry.stamp == m_stamp[entry.index]) {
+            waiting.push_back(entry);
+        }
+    }
+    std::sort(ready.begin(), ready.end(), [](const ReadyEntry& a, const ReadyEntry& b) { return ScoredAfter(b, a); });
+    std::sort(waiting.begin(), waiting.end(), [](const WaitEntry& a, const WaitEntry& b) { return WaitedLess(b, a); });
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::TakeMark() {
+    m_marks->emplace_back();
+    Mark& mark = m_marks->back();
+    mark.now = m_now;
+    mark.running = m_running;
+    mark.lastRun = m_lastRun;
+    mark.isProtected = m_protected;
+    mark.switchLeft = m_switchLeft;
+    mark.completed = m_completed;
+    mark.admitted = m_admittedBefore + m_admissions.size();
+    mark.timelineSize = m_timeline.size();
+    if (!m_timeline.empty()) {
+        mark.last = m_timeline.back();
+    }
+    mark.stats = m_stats;
+    CollectReady(mark.ready, mark.waiting);
+    for (const auto& entry : m_urgent) {
+        if (entry.stamp == m_stamp[entry.index]) {
+            mark.urgent.push_back(entry);
+        }
+    }
+    std::make_heap(mark.urgent.begin(), mark.urgent.end(), StartsLater<UrgentEntry>);
+    // Deadlines go on the heap in admission order and come off once a check
+    // passes them, so Rewind rebuilds the heap from the admission order. The
+    // processes before m_deadlinesFrom have nothing left on it.
+    while (m_deadlinesFrom < m_admissions.size() && Deadline(m_admissions[m_deadlinesFrom]) < m_checkedAt) {
+        m_deadlinesFrom++;
+    }
+    mark.deadlinesFrom = m_deadlinesFrom;
+    mark.checkedAt = m_checkedAt;
+
+    auto keep = [this, &mark](Index index) {
+        mark.active.push_back({ index, m_processes[index].remainingTime, m_estimate[index], m_stamp[index] });
+    };
+    if (m_running != NO_PROCESS) {
+        keep(m_running);
+    }
+    for (const auto& entry : mark.ready) {
+        keep(entry.index);
+    }
+}
+
+// Same schedule from here on: the same processes running and ready with the
+// same remaining work and rank, the same context loaded and switch owed.
+// Stamps and stats are history, not state.
+template <typename Time, typename Index>
+bool BasicSrtnEngine<Time, Index>::Matches(const Mark& mark) {
+    if (m_running != mark.running || m_lastRun != mark.lastRun || m_protected != mark.isProtected ||
+        m_switchLeft != mark.switchLeft || m_completed != mark.completed || m_readyCount != mark.ready.size() ||
+        m_admittedBefore + m_admissions.size() != mark.admitted) {
+        return false;
+    }
+    for (const auto& entry : mark.active) {
+        if (m_processes[entry.index].remainingTime != entry.remaining || m_estimate[entry.index] != entry.estimate) {
+            return false;
+        }
+    }
+
+    std::vector<ReadyEntry> ready;
+    std::vector<WaitEntry> waiting;
+    CollectReady(ready, waiting);
+    if (ready.size() != mark.ready.size() || waiting.size() != mark.waiting.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < ready.size(); i++) {
+        if (ready[i].score != mark.ready[i].score || ready[i].index != mark.ready[i].index) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < waiting.size(); i++) {
+        if (waiting[i].since != mark.waiting[i].since || waiting[i].index != mark.waiting[i].index) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Rewind(const Mark& mark, const std::vector<Index>& order,
+    const std::vector<Time>& bursts, const std::vector<Time>& arrivals) {
+    m_now = mark.now;
+    m_running = mark.running;
+    m_lastRun = mark.lastRun;
+    m_protected = mark.isProtected;
+    m_switchLeft = mark.switchLeft;
+    m_completed = mark.completed;
+    m_readyCount = mark.ready.size();
+    m_stats = mark.stats;
+
+    // Admission order is (arrival, index) order, so the rest of it is
+    // already a valid pending heap
+    m_pending.assign(order.begin() + mark.admitted, order.end());
+    for (Index index : m_pending) {
+        ProcessType& p = m_processes[index];
+        p.burstTime = bursts[index];
+        p.remainingTime = bursts[index];
+        p.waitingTime = 0;
+        p.turnaroundTime = 0;
+        p.completed = false;
+        m_arrival[index] = arrivals[index];
+        m_estimate[index] = bursts[index];
+        m_admission[index] = Admission::Waiting;
+    }
+    m_outstanding = 0;
+    for (const auto& entry : mark.active) {
+        m_outstanding += bursts[entry.index];
+        ProcessType& p = m_processes[entry.index];
+        p.burstTime = bursts[entry.index];
+        p.remainingTime = entry.remaining;
+        p.turnaroundTime = 0;
+        p.completed = false;
+        m_arrival[entry.index] = arrivals[entry.index];
+        m_estimate[entry.index] = entry.estimate;
+        m_stamp[entry.index] = entry.stamp;
+    }
+    m_ready = mark.ready;
+    m_waiting = mark.waiting;
+    m_urgent = mark.urgent;
+    m_deadlines.clear();
+    for (size_t i = mark.deadlinesFrom; i < mark.admitted; i++) {
+        Time deadline = Deadline(order[i]);
+        if (deadline != NO_DEADLINE && deadline >= mark.checkedAt) {
+            m_deadlines.push_back({ deadline, order[i] });
+        }
+    }
+    std::make_heap(m_deadlines.begin(), m_deadlines.end(), DueLater<DeadlineEntry>);
+    m_checkedAt = mark.checkedAt;
+
+    m_timeline.clear();
+    if (mark.timelineSize > 0) {
+        m_timeline.push_back(mark.last);
+    }
+    m_marks = nullptr;
+    m_markAt = MAX_TIME;
+    m_admissions.clear();
+    m_admittedBefore = mark.admitted;
+    m_logAdmissions = true;
+}
+
+template <typename Time, typename Index>
+void BasicSrtnEngine<Time, Index>::Revise(Index index, Time burst, Time arrival) {
+    ProcessType& p = m_processes[index];
+    p.burstTime = burst;
+    p.remainingTime = burst;
+    m_estimate[index] = burst;
+    arrival = std::max(arrival, m_now);
+    if (arrival != m_arrival[index]) {
+        m_arrival[index] = arrival;
+        auto later = [this](Index a, Index b) { return ArrivesBefore(b, a); };
+        std::make_heap(m_pending.begin(), m_pending.end(), later);
+    }
+}
+
+template <typename Time, typename Index>
+size_t BasicSrtnEngine<Time, Index>::RunToMatch(const std::vector<Mark>& marks, size_t first, Index watch) {
+    m_targets = &marks;
+    m_target = first;
+    m_matched = marks.size();
+    m_watch = watch;
+    m_watchAdmitted = watch == NO_PROCESS;
+    m_markAt = first < marks.size() ? marks[first].now : MAX_TIME;
+    Advance(MAX_TIME);
+    m_targets = nullptr;
+    m_markAt = MAX_TIME;
+    return m_matched;
+}
+
+template class BasicSrtnEngine<int, int>;
+template class BasicSrtnEngine<int32_t, uint16_t>;
+template class BasicSrtnEngine<int32_t, uint32_t>;
+template class BasicSrtnEngine<int64_t, uint16_t>;
+template class BasicSrtnEngine<int64_t, uint32_t>;
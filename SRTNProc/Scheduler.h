@@ -0,0 +1,498 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "Process.h"
+#include "SubmitQueue.h"
+
+class BurstPredictor;
+class TickPacer;
+
+// Timeline index used for time the CPU spends switching between processes
+const int CONTEXT_SWITCH_INDEX = -1;
+
+// How processes with deadlines are ranked. Processes without one rank
+// after every process that has one, by remaining time.
+enum class DeadlineMode {
+    None,           // Plain SRTN; deadlines are only accounted
+    Edf,            // Earliest deadline first
+    Slack,          // SRTN, but a process whose slack falls to slackThreshold runs next, to completion
+    LeastLaxity,    // Least deadline - now - remaining first
+};
+
+// What happens to an arrival that would take the engine past its limits.
+// An arrival always fits an engine with nothing running or ready.
+enum class AdmissionPolicy {
+    Unbounded,      // Admit everything; the limits are ignored
+    Reject,         // Refuse it; it never runs
+    Defer,          // Hold it back, in arrival order, until completions make room
+    ShedLongest,    // Admit it, then drop the ready processes with the most work left until within limits
+};
+
+// What became of a process at the submission boundary
+enum class Admission : uint8_t {
+    Waiting,    // Not yet arrived
+    Admitted,
+    Deferred,
+    Rejected,
+    Shed,       // Dropped from the ready set; never completes
+};
+
+struct SchedulerOptions {
+    int switchCost = 0;         // Time units lost every time the CPU changes process
+    int preemptThreshold = 0;   // Preempt only when the remaining-time gain exceeds this
+    int agingPeriod = 0;        // Each period spent ready counts as one unit less remaining; 0 = off
+    int maxWait = 0;            // A process ready this long runs next, to completion; 0 = off
+    DeadlineMode deadlineMode = DeadlineMode::None;
+    int slackThreshold = 0;     // Slack at which DeadlineMode::Slack overrides SRTN
+    AdmissionPolicy admission = AdmissionPolicy::Unbounded;
+    int maxReady = 0;           // Running and ready processes; 0 = no limit
+    long long maxOutstanding = 0;   // CPU time of admitted processes not yet completed; 0 = no limit
+};
+
+struct SchedulerStats {
+    long long switches = 0;     // Dispatches of a different process than the last one to run
+    long long preemptions = 0;  // Switches away from a process that had not finished
+    long long switchTime = 0;   // CPU time lost to switch cost
+    long long busyTime = 0;     // CPU time spent running processes
+    long long forced = 0;       // Dispatches made to honour maxWait
+    long long ioBlocks = 0;     // CPU bursts that ended in an I/O request
+    long long deadlineMisses = 0;   // Processes seen unfinished past their deadline
+    long long slackOverrides = 0;   // Dispatches made because slack ran out
+    long long admitted = 0;         // Arrivals admitted, at once or after a deferral
+    long long deferred = 0;
+    long long rejected = 0;
+    long long shed = 0;
+    long long admittedWork = 0;     // Bursts of the admitted processes
+    long long rejectedWork = 0;
+    long long shedWork = 0;         // Work left undone by shed processes
+    size_t peakReady = 0;
+};
+
+// Order in which a device serves its queue. Service is never preempted.
+enum class IoDiscipline {
+    Fifo,
+    ShortestFirst,  // Shortest request first, FIFO among equals
+};
+
+struct DeviceOptions {
+    IoDiscipline discipline = IoDiscipline::Fifo;
+};
+
+struct DeviceStats {
+    long long requests = 0;     // Requests served to completion
+    long long busyTime = 0;     // Time spent serving them
+    long long queueTime = 0;    // Time requests waited before service began
+    size_t maxQueue = 0;
+};
+
+// Reference scheduler: one time unit of the original per-tick algorithm.
+// Every faster engine must reproduce its ExecutionStep order and accounting
+// exactly, including the lowest-index tie-break of std::min_element.
+// Returns false (and records nothing) once every process has completed.
+bool ReferenceTick(std::vector<Process>& processes, std::vector<ExecutionStep>& sequence);
+
+// Append the per-time-unit steps covered by a segment
+void AppendSteps(const RunSegment& segment, std::vector<ExecutionStep>& sequence);
+
+// Collapse per-time-unit steps into maximal segments
+void CompressSteps(const std::vector<ExecutionStep>& sequence, std::vector<RunSegment>& segments);
+
+// Event-driven SRTN engine. Keeps the ready set in a binary heap ordered by
+// (remainingTime, index) and only makes decisions at arrivals and completions,
+// so a run costs O(events * log n) instead of O(time * n).
+// A context switch, when it has a cost, runs to completion before the next decision.
+//
+// Processes submitted with bursts alternate CPU and I/O. When a CPU burst
+// ends the process leaves the ready set and queues on its device; it becomes
+// ready again, ranked by its next CPU burst, when the device has served it.
+// Device completions are decision points like arrivals. Processes without
+// bursts pay nothing for this: their state is kept only for those with I/O.
+//
+// Aging ranks a ready process by remaining - waited / agingPeriod. Every ready
+// process ages at the same rate, so the heap orders by the time-invariant
+// score remaining * agingPeriod + readySince and nothing is re-scored as the
+// clock moves. maxWait adds a second heap ordered by readySince; entries
+// taken through one heap go stale in the other and are skipped when they
+// surface.
+//
+// Deadlines are absolute and optional. EDF and least laxity replace the
+// score: a ready process's deadline, or its latest start (deadline minus
+// remaining), does not change while it waits, so both stay heap orders. The
+// running process's latest start grows as it runs, so under least laxity
+// the next decision is when it would overtake the best ready one (damped by
+// preemptThreshold). The slack override keeps a third heap by latest start,
+// like maxWait's. A miss is counted as its deadline passes, whether or not
+// the process has finished, from a heap of deadlines that Advance stops
+// for. Aging does not apply to EDF and least laxity.
+//
+// Admission control applies at arrival. maxReady counts the running process
+// too, and maxOutstanding charges a process's whole CPU time until it
+// completes, so room opens only at decision points and a deferred process
+// goes in at the same instant however a run is sliced. Shedding takes the longest
+// ready process from a max-heap by remaining work, with stale entries skipped
+// like the other heaps' and swept out once they outnumber the live ones. A
+// job returning from I/O was admitted already: shedding applies to it, but
+// defer and reject never turn it away, so under those maxReady can be
+// overrun until completions make room. Rejected and shed processes stay in
+// Processes(), never completed, with the waiting time they had when they were
+// dropped.
+//
+// Time must be signed (int32_t or int64_t): waiting time and preemption gain
+// are differences, and -1 marks "no arrival". Index may be unsigned; its
+// all-ones value is reserved for NO_PROCESS, which is also the timeline index
+// of context switches (CONTEXT_SWITCH_INDEX for the int engine). The members
+// are defined in Scheduler.cpp and instantiated there for every supported
+// width pair.
+template <typename Time, typename Index>
+class BasicSrtnEngine {
+public:
+    typedef BasicProcess<Time> ProcessType;
+    typedef BasicRunSegment<Time, Index> Segment;
+
+    static constexpr Index NO_PROCESS = static_cast<Index>(-1);
+    static constexpr Time MAX_TIME = std::numeric_limits<Time>::max();
+    static constexpr Time NO_DEADLINE = MAX_TIME;
+
+    // Options apply from the next decision; the defaults reproduce the reference
+    void SetOptions(const SchedulerOptions& options) { m_options = options; }
+    const SchedulerOptions& Options() const { return m_options; }
+
+    // With a predictor the engine no longer knows burstTime: each process is
+    // ranked by the predictor's estimate, taken when it arrives, minus the time
+    // it has run, while execution still consumes the true burst. Completed
+    // bursts are fed back to the predictor. Null restores oracle SRTN.
+    void SetPredictor(BurstPredictor* predictor) { m_predictor = predictor; }
+
+    void Reset();
+
+    // Queue a process that becomes ready at arrivalTime (clamped to Now()).
+    // Indices are assigned in submission order, like push_back into g_processes.
+    Index Submit(const ProcessType& process, Time arrivalTime);
+
+    // Simulated I/O devices, numbered from 0. Set before submitting.
+    void SetDevices(const std::vector<DeviceOptions>& devices);
+    // A process that runs bursts[0].cpu, waits bursts[0].io on its device,
+    // runs bursts[1].cpu, and so on, ending after the first burst whose device
+    // does not exist. burstTime becomes the total CPU time. waitingTime
+    // counts only time spent ready, not time blocked on I/O.
+    Index Submit(const ProcessType& process, Time arrivalTime, const BasicBurst<Time>* bursts, size_t count);
+
+    // Submit a process arriving now and apply the admission policy at once,
+    // so an online producer learns straight away whether it was admitted,
+    // deferred or refused. Under ShedLongest, shed, if given, receives the
+    // processes dropped to make room, this one included if it went itself.
+    Admission Offer(const ProcessType& process, Index& index, std::vector<Index>* shed = nullptr);
+    Admission AdmissionOf(Index index) const { return m_admission[index]; }
+    // CPU time of admitted processes that have not completed
+    long long Outstanding() const { return m_outstanding; }
+    size_t DeferredCount() const { return m_deferred.size() - m_deferredHead; }
+
+    // Absolute deadline for a submitted process that has not yet arrived
+    void SetDeadline(Index index, Time deadline);
+
+    // Thread-safe online submission. Posted processes are picked up in batches
+    // at the next decision point and arrive at the clock time they are drained.
+    void Post(const Process& process) { m_inbox.Push(process); }
+
+    // Advance the clock to time, or stop early if there is no work left at all.
+    // Returns true while any process is still running, ready or pending.
+    bool RunUntil(Time time);
+    // Same, but the clock stops where the work runs out instead of idling on
+    // to time, as the GUI's clock always has
+    bool RunBusyUntil(Time time);
+    void RunToCompletion();
+
+    // Real-time runs: advance to the tick the pacer's wall clock has reached
+    // and report it, so the pacer's lateness shows whether the engine keeps up
+    bool RunPaced(TickPacer& pacer);
+
+    bool HasWork() const;
+    Time Now() const { return m_now; }
+    Index Running() const { return m_running; }
+    size_t ReadyCount() const { return m_readyCount; }
+    size_t PendingCount() const { return m_pending.size(); }
+    size_t CompletedCount() const { return m_completed; }
+    size_t ProcessCount() const { return m_processes.size(); }
+
+    // Processes with waitingTime/turnaroundTime filled in as of Now()
+    const std::vector<ProcessType>& Processes();
+    const std::vector<Segment>& Timeline() const { return m_timeline; }
+    // Append each process that completes to log, in completion order, until
+    // set back to null. Lets a consumer take completions as they happen.
+    void RecordCompletions(std::vector<Index>* log) { m_completionLog = log; }
+    // Drop every timeline segment but the last, which the next slice may
+    // still extend, once a streaming consumer has taken them. Keeps a long
+    // run's memory flat; not for runs recording what-if marks.
+    void TrimTimeline();
+    const SchedulerStats& Stats() const { return m_stats; }
+    // Burst each process was ranked by; equals burstTime without a predictor
+    const std::vector<Time>& Estimates() const { return m_estimate; }
+    const std::vector<DeviceStats>& DeviceStatistics() const { return m_deviceStats; }
+    // Each process's deadline, NO_DEADLINE where it has none; empty when no
+    // process has one
+    const std::vector<Time>& Deadlines() const { return m_deadline; }
+    size_t BlockedCount() const { return m_blocked; }
+
+    // Arrival each process was queued with, after clamping to the clock
+    const std::vector<Time>& Arrivals() const { return m_arrival; }
+    // One process as the engine holds it; waiting and turnaround are final
+    // only once it has completed (Processes() fills in the rest)
+    const ProcessType& ProcessAt(Index index) const { return m_processes[index]; }
+
+    // Bytes held by the engine's own arrays, excluding process names
+    size_t MemoryUsage() const;
+
+    // Binary checkpoint of everything the run depends on: clock, heaps,
+    // pending arrivals, per-process accounting, timeline, options, stats, I/O
+    // devices with their queues and blocked processes, and the predictor's
+    // averages (see Checkpoint.h). Posted processes are
+    // drained first, arriving now as they would at the next decision. A
+    // loaded engine continues exactly as the saved one would have. Loading
+    // needs an engine of the same widths, and a predictor attached if the
+    // saved engine had one; on failure the engine is left reset. The saved
+    // devices replace the loading engine's.
+    void SaveState(std::vector<unsigned char>& out);
+    bool LoadState(const std::vector<unsigned char>& in, std::string& error);
+
+    // What-if support (see WhatIf.h). A mark is the state at an event
+    // boundary, defined after the class.
+    struct Mark;
+
+    // Before a run: record a mark at the first event boundary at or after
+    // every multiple of `every`, and log admissions. A mark is skipped until
+    // the run has admitted and completed as many processes as the last mark
+    // holds. Null stops recording; the log stays readable.
+    void RecordMarks(std::vector<Mark>* marks, Time every);
+    // Processes admitted since recording started or the last Rewind, in order
+    const std::vector<Index>& Admissions() const { return m_admissions; }
+
+    // Return to a mark of a recorded run without predictor or admission
+    // policy, since deferred, refused and shed processes are not part of a
+    // mark. `order` is that run's Admissions(); every process after the first
+    // mark.admitted of it is pending again, unstarted, with the given burst
+    // and arrival. Running and ready processes come back from the mark.
+    // Completed processes are left as they are, since they can no longer
+    // change the schedule. The timeline restarts with the mark's last segment.
+    void Rewind(const Mark& mark, const std::vector<Index>& order,
+        const std::vector<Time>& bursts, const std::vector<Time>& arrivals);
+    // Change a pending process before it arrives
+    void Revise(Index index, Time burst, Time arrival);
+    // Run until an event boundary of marks[first..] finds the engine in
+    // exactly the marked state with `watch` admitted, or until no work is
+    // left. Returns the matched mark, or marks.size().
+    size_t RunToMatch(const std::vector<Mark>& marks, size_t first, Index watch);
+
+private:
+    struct ReadyEntry {
+        long long score;
+        Index index;
+        uint32_t stamp;         // Stale unless equal to m_stamp[index]
+    };
+
+    struct WaitEntry {
+        Time since;
+        Index index;
+        uint32_t stamp;
+    };
+
+    struct UrgentEntry {
+        Time latestStart;       // deadline - remaining: when slack runs out
+        Index index;
+        uint32_t stamp;
+    };
+
+    struct LongestEntry {
+        Time remaining;
+        Index index;
+        uint32_t stamp;
+    };
+
+    struct DeadlineEntry {
+        Time deadline;
+        Index index;
+    };
+
+    // Where a process with I/O is in its bursts
+    struct IoPlan {
+        uint32_t next;          // Burst now running or waiting, in m_bursts
+        uint32_t end;
+        Time cpuEnd;            // remainingTime when the current CPU burst is done
+        Time blockedSince;      // -1 while not blocked
+        Time ioTime;            // Time spent blocked so far
+    };
+
+    struct IoRequest {
+        long long key;          // Arrival order for FIFO, length for shortest first
+        uint64_t sequence;
+        Index index;
+        Time length;
+        Time queuedAt;
+    };
+
+    struct Device {
+        IoDiscipline discipline;
+        std::vector<IoRequest> queue;   // min-heap by (key, sequence)
+        Index serving;
+        Time doneAt;
+    };
+
+    Time Key(Index index) const;
+    long long Score(Index index, Time since) const;
+    bool ArrivesBefore(Index a, Index b) const;
+    void MakeReady(Index index);
+    Index TopReady();
+    Index OldestReady();
+    Index MostUrgent();
+    Time Deadline(Index index) const;
+    void CheckDeadlines();
+    void TakeReady(Index index);
+    void DrainInbox();
+    void AdmitArrivals();
+    void Arrive(Index index);
+    void Admit(Index index);
+    void AdmitDeferred();
+    bool Fits(Time work) const;
+    size_t Occupancy() const { return m_readyCount + (m_running != NO_PROCESS ? 1 : 0); }
+    void ShedExcess();
+    void Advance(Time horizon);
+    void Dispatch();
+    void Execute(Time length);
+    void Record(Index processIndex, Time length);
+    void Complete(Index index);
+    Time NextArrival() const;
+    Time NextIo() const;
+    IoPlan* PlanOf(Index index);
+    Time CpuEnd(Index index);
+    Time IoTime(Index index);
+    void Block(Index index);
+    void StartIo(size_t device, Time at);
+    void FinishIo(size_t device);
+    void ProcessIo();
+    bool AtMark();
+    void TakeMark();
+    bool Matches(const Mark& mark);
+    void CollectReady(std::vector<ReadyEntry>& ready, std::vector<WaitEntry>& waiting) const;
+
+    std::vector<ProcessType> m_processes;
+    std::vector<Time> m_arrival;
+    std::vector<Time> m_estimate;
+    std::vector<uint32_t> m_stamp;
+    std::vector<ReadyEntry> m_ready;    // min-heap by (score, index)
+    std::vector<WaitEntry> m_waiting;   // min-heap by (since, index), only with maxWait
+    std::vector<Index> m_pending;       // min-heap of indices by (arrival, index)
+    std::vector<Time> m_deadline;       // Empty until a deadline is set
+    std::vector<UrgentEntry> m_urgent;  // min-heap by (latestStart, index), only with the slack override
+    std::vector<DeadlineEntry> m_deadlines; // min-heap of deadlines not yet passed
+    Time m_checkedAt = 0;               // Clock at the last CheckDeadlines
+    std::vector<Admission> m_admission;
+    std::vector<LongestEntry> m_longest;    // max-heap by (remaining, index), only when shedding
+    std::vector<Index> m_deferred;      // Queue from m_deferredHead, in arrival order
+    size_t m_deferredHead = 0;
+    long long m_outstanding = 0;
+    std::vector<Segment> m_timeline;
+    SubmitQueue m_inbox;
+    std::vector<Process> m_drained;
+    SchedulerOptions m_options;
+    SchedulerStats m_stats;
+    BurstPredictor* m_predictor = nullptr;
+    size_t m_completed = 0;
+    std::vector<Index>* m_completionLog = nullptr;
+    std::vector<Index>* m_shedLog = nullptr;    // Set only during Offer
+    size_t m_readyCount = 0;
+    Index m_running = NO_PROCESS;
+    bool m_protected = false;   // Running to honour maxWait; not preemptible
+    Index m_lastRun = NO_PROCESS;   // Process whose context is loaded on the CPU
+    Time m_switchLeft = 0;      // Switch time still owed before m_running can run
+    Time m_now = 0;
+
+    // I/O state, only for processes submitted with bursts
+    std::vector<BasicBurst<Time>> m_bursts;
+    std::vector<IoPlan> m_plans;        // By process; empty until one has I/O
+    std::vector<Device> m_devices;
+    std::vector<DeviceStats> m_deviceStats;
+    uint64_t m_ioSequence = 0;
+    size_t m_blocked = 0;
+
+    // What-if state: Advance calls AtMark at the first event boundary at or
+    // after m_markAt, either to record into m_marks or to match m_targets
+    Time m_markAt = MAX_TIME;
+    Time m_markEvery = 0;
+    std::vector<Mark>* m_marks = nullptr;
+    const std::vector<Mark>* m_targets = nullptr;
+    size_t m_target = 0;
+    size_t m_matched = 0;
+    std::vector<Index> m_admissions;
+    size_t m_admittedBefore = 0;    // Admissions the log does not hold, from before a Rewind
+    size_t m_deadlinesFrom = 0;     // Admissions before this have no deadline still on the heap
+    bool m_logAdmissions = false;
+    Index m_watch = NO_PROCESS;
+    bool m_watchAdmitted = false;
+};
+
+// Only the running and ready processes are copied: pending ones are still
+// as submitted and completed ones cannot change the schedule, so a mark
+// stays small while the run is large. Deadlines not yet passed are kept too,
+// since a completed process can still miss one.
+template <typename Time, typename Index>
+struct BasicSrtnEngine<Time, Index>::Mark {
+    struct Active {
+        Index index;
+        Time remaining;
+        Time estimate;
+        uint32_t stamp;
+    };
+
+    Time now = 0;
+    Index running = NO_PROCESS;
+    Index lastRun = NO_PROCESS;
+    bool isProtected = false;
+    Time switchLeft = 0;
+    size_t completed = 0;
+    size_t admitted = 0;        // Length of the admission order so far
+    size_t timelineSize = 0;
+    Segment last = {};          // Last timeline segment as of the mark
+    SchedulerStats stats;
+    std::vector<Active> active;         // Running process first, then the ready ones
+    std::vector<ReadyEntry> ready;      // Live entries by (score, index), so already a heap
+    std::vector<WaitEntry> waiting;     // Live entries by (since, index)
+    std::vector<UrgentEntry> urgent;    // Live entries, as a heap
+    // Deadlines still to check: of the admissions from deadlinesFrom on, those
+    // not before checkedAt
+    size_t deadlinesFrom = 0;
+    Time checkedAt = 0;
+};
+
+// The engine the GUI, the service and the verifier use
+typedef BasicSrtnEngine<int, int> SrtnEngine;
+
+// Which of the instantiated engines to run: 64-bit instead of 32-bit time,
+// 32-bit instead of 16-bit indices
+struct EngineWidths {
+    bool wideTime = false;
+    bool wideIndex = false;
+};
+
+// Call fn(engine) with a fresh engine of the given widths
+template <typename Fn>
+void WithEngineWidths(const EngineWidths& widths, Fn fn) {
+    if (widths.wideTime && widths.wideIndex) {
+        BasicSrtnEngine<int64_t, uint32_t> engine;
+        fn(engine);
+    }
+    else if (widths.wideTime) {
+        BasicSrtnEngine<int64_t, uint16_t> engine;
+        fn(engine);
+    }
+    else if (widths.wideIndex) {
+        BasicSrtnEngine<int32_t, uint32_t> engine;
+        fn(engine);
+    }
+    else {
+        BasicSrtnEngine<int32_t, uint16_t> engine;
+        fn(engine);
+    }
+}
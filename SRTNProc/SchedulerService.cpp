@@ -0,0 +1,795 @@
+#include "SchedulerService.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Checkpoint.h"
+#include "Metrics.h"
+#include "Report.h"
+#include "TickPacer.h"
+#include "TimelineIndex.h"
+
+namespace {
+
+#ifdef _WIN32
+typedef SOCKET SocketHandle;
+const SocketHandle NO_SOCKET = INVALID_SOCKET;
+const int SEND_FLAGS = 0;
+
+void CloseSocket(SocketHandle socket) { closesocket(socket); }
+bool WouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+void SetNonBlocking(SocketHandle socket) {
+    u_long enable = 1;
+    ioctlsocket(socket, FIONBIO, &enable);
+}
+
+struct NetworkSession {
+    NetworkSession() {
+        WSADATA data;
+        WSAStartup(MAKEWORD(2, 2), &data);
+    }
+    ~NetworkSession() { WSACleanup(); }
+};
+#else
+typedef int SocketHandle;
+const SocketHandle NO_SOCKET = -1;
+const int SEND_FLAGS = MSG_NOSIGNAL;
+
+void CloseSocket(SocketHandle socket) { close(socket); }
+bool WouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+void SetNonBlocking(SocketHandle socket) {
+    fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK);
+}
+
+struct NetworkSession {
+    NetworkSession() {}
+};
+#endif
+
+struct SocketEvent {
+    SocketHandle socket;
+    bool readable;
+    bool writable;
+    bool failed;
+};
+
+// Readiness notification over many sockets: epoll on Linux, WSAPoll on Windows
+class Poller {
+public:
+    Poller();
+    ~Poller();
+    Poller(const Poller&) = delete;
+    Poller& operator=(const Poller&) = delete;
+
+    void Add(SocketHandle socket);
+    void Remove(SocketHandle socket);
+    // A socket is always watched for errors; reads may be dropped once the
+    // peer has closed its side, so its end-of-file does not fire forever
+    void Watch(SocketHandle socket, bool reads, bool writes);
+    void Wait(int timeoutMs, std::vector<SocketEvent>& events);
+
+private:
+#ifdef _WIN32
+    std::vector<WSAPOLLFD> m_fds;
+    std::unordered_map<SocketHandle, size_t> m_slots;
+#else
+    int m_epoll;
+    std::vector<epoll_event> m_ready;
+#endif
+};
+
+#ifdef _WIN32
+Poller::Poller() {}
+Poller::~Poller() {}
+
+void Poller::Add(SocketHandle socket) {
+    m_slots[socket] = m_fds.size();
+    m_fds.push_back({ socket, POLLRDNORM, 0 });
+}
+
+void Poller::Remove(SocketHandle socket) {
+    auto slot = m_slots.find(socket);
+    if (slot == m_slots.end()) {
+        return;
+    }
+    size_t index = slot->second;
+    m_slots.erase(slot);
+    if (index + 1 != m_fds.size()) {
+        m_fds[index] = m_fds.back();
+        m_slots[m_fds[index].fd] = index;
+    }
+    m_fds.pop_back();
+}
+
+void Poller::Watch(SocketHandle socket, bool reads, bool writes) {
+    auto slot = m_slots.find(socket);
+    if (slot != m_slots.end()) {
+        m_fds[slot->second].events = (reads ? POLLRDNORM : 0) | (writes ? POLLWRNORM : 0);
+    }
+}
+
+void Poller::Wait(int timeoutMs, std::vector<SocketEvent>& events) {
+    events.clear();
+    if (WSAPoll(m_fds.data(), static_cast<ULONG>(m_fds.size()), timeoutMs) <= 0) {
+        return;
+    }
+    for (const auto& fd : m_fds) {
+        if (fd.revents != 0) {
+            events.push_back({ fd.fd,
+                (fd.revents & (POLLRDNORM | POLLHUP)) != 0,
+                (fd.revents & POLLWRNORM) != 0,
+                (fd.revents & (POLLERR | POLLNVAL)) != 0 });
+        }
+    }
+}
+#else
+Poller::Poller() : m_epoll(epoll_create1(0)), m_ready(1024) {}
+Poller::~Poller() { close(m_epoll); }
+
+void Poller::Add(SocketHandle socket) {
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = socket;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, socket, &event);
+}
+
+void Poller::Remove(SocketHandle socket) {
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, socket, nullptr);
+}
+
+void Poller::Watch(SocketHandle socket, bool reads, bool writes) {
+    epoll_event event = {};
+    event.events = (reads ? static_cast<uint32_t>(EPOLLIN) : 0) | (writes ? static_cast<uint32_t>(EPOLLOUT) : 0);
+    event.data.fd = socket;
+    epoll_ctl(m_epoll, EPOLL_CTL_MOD, socket, &event);
+}
+
+void Poller::Wait(int timeoutMs, std::vector<SocketEvent>& events) {
+    events.clear();
+    int count = epoll_wait(m_epoll, m_ready.data(), static_cast<int>(m_ready.size()), timeoutMs);
+    for (int i = 0; i < count; i++) {
+        const epoll_event& event = m_ready[i];
+        events.push_back({ event.data.fd,
+            (event.events & (EPOLLIN | EPOLLHUP)) != 0,
+            (event.events & EPOLLOUT) != 0,
+            (event.events & EPOLLERR) != 0 });
+    }
+}
+#endif
+
+SocketHandle OpenSocket(const std::string& socketPath, unsigned short port, bool listening) {
+#ifndef _WIN32
+    if (!socketPath.empty()) {
+        SocketHandle socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        if (listening) {
+            unlink(socketPath.c_str());
+        }
+        int result = listening
+            ? bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address))
+            : connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        if (result != 0 || (listening && listen(socket, SOMAXCONN) != 0)) {
+            CloseSocket(socket);
+            return NO_SOCKET;
+        }
+        return socket;
+    }
+#endif
+    SocketHandle socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (socket == NO_SOCKET) {
+        return NO_SOCKET;
+    }
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int enable = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&enable), sizeof(enable));
+    if (listening) {
+        setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&enable), sizeof(enable));
+    }
+    int result = listening
+        ? bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address))
+        : connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    if (result != 0 || (listening && listen(socket, SOMAXCONN) != 0)) {
+        CloseSocket(socket);
+        return NO_SOCKET;
+    }
+    return socket;
+}
+
+// Splits off the next space-separated token
+std::string_view NextToken(std::string_view& line) {
+    size_t start = line.find_first_not_of(' ');
+    if (start == std::string_view::npos) {
+        line = std::string_view();
+        return line;
+    }
+    size_t end = line.find(' ', start);
+    std::string_view token = line.substr(start, end == std::string_view::npos ? end : end - start);
+    line = end == std::string_view::npos ? std::string_view() : line.substr(end);
+    return token;
+}
+
+bool ParseInt(std::string_view token, long long& value) {
+    if (token.empty() || token.size() > 18) {
+        return false;
+    }
+    value = 0;
+    for (char c : token) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    return true;
+}
+
+struct Connection {
+    std::string input;
+    std::string output;
+    size_t written = 0;
+    int batchLeft = 0;          // Job lines still expected for the current BATCH
+    int batchFirst = -1;
+    int batchCount = 0;
+    int batchDeferred = 0;
+    int batchRefused = 0;
+    int batchShed = 0;          // Earlier jobs dropped to make room for the batch's
+    bool batchFailed = false;
+    bool closing = false;
+};
+
+class Service {
+public:
+    explicit Service(const ServiceOptions& options)
+        : m_options(options),
+          m_pacer(std::chrono::nanoseconds(options.rate > 0 ? static_cast<long long>(1e9 / options.rate) : 1)) {}
+    int Run();
+
+private:
+    void AdvanceClock();
+    int PollTimeout() const;
+    void Accept();
+    void Read(SocketHandle socket, Connection& connection);
+    void Flush(SocketHandle socket, Connection& connection);
+    void Close(SocketHandle socket);
+    void Handle(Connection& connection, std::string_view line);
+    bool SubmitJob(std::string_view line, int& index, Admission& admission);
+    size_t Checkpoint();
+
+    ServiceOptions m_options;
+    SrtnEngine m_engine;
+    TimelineIndex m_index;      // Caught up with the engine's timeline by each query
+    std::vector<RunSegment> m_found;
+    std::vector<int> m_shed;    // Jobs the last SubmitJob pushed out, itself excluded
+    std::unique_ptr<CheckpointWriter> m_checkpoints;
+    std::vector<unsigned char> m_snapshot;
+    long long m_nextCheckpoint = 0;
+    Poller m_poller;
+    SocketHandle m_listener = NO_SOCKET;
+    std::unordered_map<SocketHandle, Connection> m_connections;
+    TickPacer m_pacer;          // One tick per simulated time unit
+    bool m_shutdown = false;
+};
+
+void Service::AdvanceClock() {
+    if (m_options.rate <= 0) {
+        // Free-running: finish whatever has been submitted
+        m_engine.RunToCompletion();
+    }
+    else {
+        m_engine.RunPaced(m_pacer);
+    }
+    if (m_options.checkpointEvery > 0 && m_engine.Now() >= m_nextCheckpoint) {
+        Checkpoint();
+        m_nextCheckpoint = m_engine.Now() + m_options.checkpointEvery;
+    }
+}
+
+// Captures the engine in memory; the file is written in the background.
+// Returns the checkpoint size, or 0 without a checkpoint file.
+size_t Service::Checkpoint() {
+    if (!m_checkpoints) {
+        return 0;
+    }
+    m_engine.SaveState(m_snapshot);
+    size_t bytes = m_snapshot.size();
+    m_checkpoints->Write(m_snapshot);
+    return bytes;
+}
+
+// Wake up in time for the next simulated time unit
+int Service::PollTimeout() const {
+    if (m_options.rate <= 0) {
+        return 50;
+    }
+    long long until = std::chrono::duration_cast<std::chrono::milliseconds>(m_pacer.UntilNextTick()).count() + 1;
+    return static_cast<int>(std::min<long long>(std::max<long long>(until, 0), 50));
+}
+
+int Service::Run() {
+    NetworkSession network;
+    m_listener = OpenSocket(m_options.socketPath, m_options.port, true);
+    if (m_listener == NO_SOCKET) {
+        fprintf(stderr, "serve: cannot listen on %s\n",
+            m_options.socketPath.empty() ? std::to_string(m_options.port).c_str() : m_options.socketPath.c_str());
+        return 1;
+    }
+    SetNonBlocking(m_listener);
+    m_poller.Add(m_listener);
+    m_engine.SetOptions(m_options.scheduler);
+    if (!m_options.resumePath.empty()) {
+        std::vector<unsigned char> bytes;
+        std::string error = "cannot read file";
+        if (!ReadWholeFile(m_options.resumePath, bytes) || !m_engine.LoadState(bytes, error)) {
+            fprintf(stderr, "serve: cannot resume from %s: %s\n", m_options.resumePath.c_str(), error.c_str());
+            return 1;
+        }
+        printf("serve: resumed at clock %d with %zu processes\n", m_engine.Now(), m_engine.ProcessCount());
+    }
+    if (!m_options.checkpointPath.empty()) {
+        m_checkpoints.reset(new CheckpointWriter(m_options.checkpointPath));
+        m_nextCheckpoint = m_engine.Now() + m_options.checkpointEvery;
+    }
+    // A resumed clock carries on from where it stopped instead of waiting for
+    // the wall clock to catch up
+    m_pacer.Start(m_engine.Now());
+    printf("serve: listening on %s, %.0f time units/s\n",
+        m_options.socketPath.empty() ? ("127.0.0.1:" + std::to_string(m_options.port)).c_str() : m_options.socketPath.c_str(),
+        m_options.rate);
+    fflush(stdout);
+
+    std::vector<SocketEvent> events;
+    while (!m_shutdown) {
+        m_poller.Wait(PollTimeout(), events);
+        AdvanceClock();
+        for (const auto& event : events) {
+            if (event.socket == m_listener) {
+                Accept();
+                continue;
+            }
+            auto found = m_connections.find(event.socket);
+            if (found == m_connections.end()) {
+                continue;
+            }
+            if (event.failed) {
+                Close(event.socket);
+                continue;
+            }
+            if (event.readable) {
+                Read(event.socket, found->second);
+            }
+            else if (event.writable) {
+                Flush(event.socket, found->second);
+            }
+        }
+    }
+
+    while (!m_connections.empty()) {
+        Close(m_connections.begin()->first);
+    }
+    m_poller.Remove(m_listener);
+    CloseSocket(m_listener);
+#ifndef _WIN32
+    if (!m_options.socketPath.empty()) {
+        unlink(m_options.socketPath.c_str());
+    }
+#endif
+    return 0;
+}
+
+void Service::Accept() {
+    for (;;) {
+        SocketHandle socket = accept(m_listener, nullptr, nullptr);
+        if (socket == NO_SOCKET) {
+            return;
+        }
+        SetNonBlocking(socket);
+        m_poller.Add(socket);
+        m_connections[socket];
+    }
+}
+
+void Service::Read(SocketHandle socket, Connection& connection) {
+    char buffer[16384];
+    bool eof = false;
+    for (;;) {
+        int received = recv(socket, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection.input.append(buffer, received);
+            continue;
+        }
+        if (received < 0 && WouldBlock()) {
+            break;
+        }
+        if (received < 0) {
+            Close(socket);
+            return;
+        }
+        // The peer closed its side: answer what it sent, then close
+        eof = true;
+        connection.closing = true;
+        break;
+    }
+
+    // Handle every complete line; a partial line waits for the next read
+    size_t start = 0;
+    for (;;) {
+        size_t end = connection.input.find('\n', start);
+        if (end == std::string::npos) {
+            break;
+        }
+        std::string_view line(connection.input.data() + start, end - start);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        Handle(connection, line);
+        start = end + 1;
+    }
+    connection.input.erase(0, start);
+    // No newline is coming after the last line
+    if (eof && !connection.input.empty()) {
+        std::string_view line(connection.input);
+        if (line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        Handle(connection, line);
+        connection.input.clear();
+    }
+    Flush(socket, connection);
+}
+
+void Service::Flush(SocketHandle socket, Connection& connection) {
+    while (connection.written < connection.output.size()) {
+        int sent = send(socket, connection.output.data() + connection.written,
+            static_cast<int>(connection.output.size() - connection.written), SEND_FLAGS);
+        if (sent > 0) {
+            connection.written += sent;
+            continue;
+        }
+        if (sent < 0 && WouldBlock()) {
+            m_poller.Watch(socket, !connection.closing, true);
+            return;
+        }
+        Close(socket);
+        return;
+    }
+    connection.output.clear();
+    connection.written = 0;
+    if (connection.closing) {
+        Close(socket);
+        return;
+    }
+    m_poller.Watch(socket, true, false);
+}
+
+void Service::Close(SocketHandle socket) {
+    m_poller.Remove(socket);
+    CloseSocket(socket);
+    m_connections.erase(socket);
+}
+
+bool Service::SubmitJob(std::string_view line, int& index, Admission& admission) {
+    std::string_view name = NextToken(line);
+    long long burst = 0;
+    if (name.empty() || !ParseInt(NextToken(line), burst) || burst <= 0 || burst > INT_MAX) {
+        return false;
+    }
+    Process process = { ProcessNames().Intern(std::wstring(name.begin(), name.end())), static_cast<int>(burst),
+        static_cast<int>(burst), m_engine.Now(), 0, 0, false };
+    m_shed.clear();
+    admission = m_engine.Offer(process, index, &m_shed);
+    m_shed.erase(std::remove(m_shed.begin(), m_shed.end(), index), m_shed.end());
+    return true;
+}
+
+void Service::Handle(Connection& connection, std::string_view line) {
+    std::string& out = connection.output;
+
+    if (connection.batchLeft > 0) {
+        int index = -1;
+        Admission admission = Admission::Admitted;
+        if (SubmitJob(line, index, admission)) {
+            if (connection.batchFirst < 0) {
+                connection.batchFirst = index;
+            }
+            connection.batchCount++;
+            connection.batchDeferred += admission == Admission::Deferred ? 1 : 0;
+            connection.batchRefused += admission == Admission::Rejected || admission == Admission::Shed ? 1 : 0;
+            connection.batchShed += static_cast<int>(m_shed.size());
+        }
+        else {
+            connection.batchFailed = true;
+        }
+        if (--connection.batchLeft == 0) {
+            out += connection.batchFailed ? "ERR bad job line in batch, accepted " : "OK ";
+            out += std::to_string(connection.batchFirst) + " " + std::to_string(connection.batchCount);
+            // Backpressure: how many of the jobs admission control held back or refused
+            if (connection.batchDeferred > 0 || connection.batchRefused > 0 || connection.batchShed > 0) {
+                out += " deferred=" + std::to_string(connection.batchDeferred) +
+                    " rejected=" + std::to_string(connection.batchRefused) +
+                    " shed=" + std::to_string(connection.batchShed);
+            }
+            out += "\n";
+        }
+        return;
+    }
+
+    std::string_view command = NextToken(line);
+    MetricAdd(Counter::ServiceRequests);
+    if (command == "SUBMIT") {
+        int index = -1;
+        Admission admission = Admission::Admitted;
+        if (!SubmitJob(line, index, admission)) {
+            out += "ERR usage: SUBMIT <name> <burst>\n";
+        }
+        else {
+            const char* reply = admission == Admission::Deferred ? "DEFERRED " :
+                admission == Admission::Rejected || admission == Admission::Shed ? "REJECTED " : "OK ";
+            out += reply + std::to_string(index);
+            // Earlier jobs the limits dropped to admit this one
+            for (size_t i = 0; i < m_shed.size(); i++) {
+                out += (i == 0 ? " shed=" : ",") + std::to_string(m_shed[i]);
+            }
+            out += "\n";
+        }
+    }
+    else if (command == "BATCH") {
+        long long count = 0;
+        if (!ParseInt(NextToken(line), count) || count <= 0 || count > INT_MAX) {
+            out += "ERR usage: BATCH <count>\n";
+            return;
+        }
+        connection.batchLeft = static_cast<int>(count);
+        connection.batchFirst = -1;
+        connection.batchCount = 0;
+        connection.batchDeferred = 0;
+        connection.batchRefused = 0;
+        connection.batchShed = 0;
+        connection.batchFailed = false;
+    }
+    else if (command == "STATE") {
+        out += "STATE now=" + std::to_string(m_engine.Now()) +
+            " running=" + std::to_string(m_engine.Running()) +
+            " ready=" + std::to_string(m_engine.ReadyCount()) +
+            " pending=" + std::to_string(m_engine.PendingCount()) +
+            " completed=" + std::to_string(m_engine.CompletedCount()) +
+            " total=" + std::to_string(m_engine.ProcessCount()) + "\n";
+    }
+    else if (command == "STATS") {
+        const SchedulerStats& stats = m_engine.Stats();
+        RunSummary summary = Summarize(m_engine.Processes(), m_engine.Now());
+        char text[512];
+        snprintf(text, sizeof(text),
+            "STATS switches=%lld preemptions=%lld switch_time=%lld busy=%lld completed=%zu "
+            "mean_turnaround=%.2f p99_turnaround=%lld max_turnaround=%lld "
+            "late_us=%lld late_p99_us=%lld late_max_us=%lld caught_up=%lld "
+            "admitted=%lld deferred=%lld rejected=%lld shed=%lld outstanding=%lld\n",
+            stats.switches, stats.preemptions, stats.switchTime, stats.busyTime, summary.completed,
+            summary.meanTurnaround, summary.p99Turnaround, summary.maxTurnaround,
+            m_pacer.Stats().lastLatenessMicros, m_pacer.LatenessPercentile(99), m_pacer.Stats().maxLatenessMicros,
+            m_pacer.Stats().caughtUp, stats.admitted, stats.deferred, stats.rejected, stats.shed,
+            m_engine.Outstanding());
+        out += text;
+    }
+    else if (command == "TIMELINE") {
+        long long since = 0;
+        long long limit = 10000;
+        if (!ParseInt(NextToken(line), since)) {
+            out += "ERR usage: TIMELINE <time> [max]\n";
+            return;
+        }
+        std::string_view max = NextToken(line);
+        if (!max.empty() && !ParseInt(max, limit)) {
+            out += "ERR usage: TIMELINE <time> [max]\n";
+            return;
+        }
+        // Segments are appended in time order, so the first one still
+        // running at or after `since` can be found by binary search
+        const auto& timeline = m_engine.Timeline();
+        auto first = std::partition_point(timeline.begin(), timeline.end(),
+            [since](const RunSegment& s) { return s.startTime + s.length <= since; });
+        long long count = 0;
+        for (auto it = first; it != timeline.end() && count < limit; ++it, ++count) {
+            out += "SEG " + std::to_string(it->processIndex) + " " + std::to_string(it->startTime) +
+                " " + std::to_string(it->length) + "\n";
+        }
+        out += "END " + std::to_string(count) + "\n";
+    }
+    else if (command == "AT" || command == "SLICES" || command == "RANGE") {
+        long long first = 0;
+        long long second = 0;
+        long long limit = 10000;
+        bool ok = ParseInt(NextToken(line), first);
+        if (ok && command == "RANGE") {
+            ok = ParseInt(NextToken(line), second);
+        }
+        std::string_view max = NextToken(line);
+        if (!ok || first < 0 || first > INT_MAX || second < 0 || second > INT_MAX ||
+            (!max.empty() && !ParseInt(max, limit)) || limit < 0) {
+            out += command == "AT" ? "ERR usage: AT <time>\n" : command == "SLICES" ?
+                "ERR usage: SLICES <index> [max]\n" : "ERR usage: RANGE <from> <to> [max]\n";
+            return;
+        }
+        m_index.Update(m_engine.Timeline());
+        m_found.clear();
+        if (command == "AT") {
+            size_t position = m_index.At(static_cast<int>(first));
+            if (position == TimelineIndex::NONE) {
+                out += "IDLE\n";
+                return;
+            }
+            m_found.push_back(m_index.SegmentAt(position));
+        }
+        else if (command == "SLICES") {
+            m_index.SlicesOf(static_cast<int>(first), m_found, static_cast<size_t>(limit));
+        }
+        else {
+            m_index.Overlapping(static_cast<int>(first), static_cast<int>(second), m_found, static_cast<size_t>(limit));
+        }
+        for (const auto& segment : m_found) {
+            out += "SEG " + std::to_string(segment.processIndex) + " " + std::to_string(segment.startTime) +
+                " " + std::to_string(segment.length) + "\n";
+        }
+        if (command != "AT") {
+            out += "END " + std::to_string(m_found.size()) + "\n";
+        }
+    }
+    else if (command == "METRICS") {
+        // Prometheus text by default, one JSON line with METRICS JSON
+        out += NextToken(line) == "JSON" ? MetricsJson() + "\n" : MetricsPrometheus();
+        out += "END\n";
+    }
+    else if (command == "CHECKPOINT") {
+        size_t bytes = Checkpoint();
+        out += bytes > 0 ? "OK " + std::to_string(bytes) + "\n" : "ERR no checkpoint file, start with --checkpoint\n";
+    }
+    else if (command == "QUIT") {
+        out += "OK\n";
+        connection.closing = true;
+    }
+    else if (command == "SHUTDOWN") {
+        // The final state is what a later --resume should pick up
+        Checkpoint();
+        out += "OK\n";
+        connection.closing = true;
+        m_shutdown = true;
+    }
+    else if (!command.empty()) {
+        out += "ERR unknown command\n";
+    }
+}
+
+} // namespace
+
+int RunSchedulerService(const ServiceOptions& options) {
+    Service service(options);
+    return service.Run();
+}
+
+int RunServiceLoadTest(const ServiceLoadOptions& options) {
+    NetworkSession network;
+
+    struct Client {
+        SocketHandle socket;
+        int roundsLeft;
+        std::chrono::steady_clock::time_point sent;
+        std::string input;
+    };
+    std::vector<Client> clients;
+    std::unordered_map<SocketHandle, size_t> bySocket;
+    Poller poller;
+
+    std::string request = "BATCH " + std::to_string(options.batch) + "\n";
+    for (int i = 0; i < options.batch; i++) {
+        request += "load-" + std::to_string(i % 8) + " " + std::to_string(1 + i % 13) + "\n";
+    }
+
+    for (int i = 0; i < options.connections; i++) {
+        SocketHandle socket = OpenSocket(options.socketPath, options.port, false);
+        if (socket == NO_SOCKET) {
+            fprintf(stderr, "serve-load: connection %d failed\n", i);
+            break;
+        }
+        bySocket[socket] = clients.size();
+        clients.push_back({ socket, options.rounds, {}, {} });
+        poller.Add(socket);
+    }
+
+    // Requests are small enough to go out in one send on a fresh socket
+    auto sendRequest = [&](Client& client) {
+        client.sent = std::chrono::steady_clock::now();
+        send(client.socket, request.data(), static_cast<int>(request.size()), SEND_FLAGS);
+        client.roundsLeft--;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto& client : clients) {
+        sendRequest(client);
+    }
+
+    std::vector<int> latencyUs;
+    latencyUs.reserve(static_cast<size_t>(clients.size()) * options.rounds);
+    size_t active = clients.size();
+    std::vector<SocketEvent> events;
+    char buffer[4096];
+    long long errors = 0;
+    while (active > 0) {
+        poller.Wait(1000, events);
+        if (events.empty()) {
+            fprintf(stderr, "serve-load: timed out waiting for replies\n");
+            break;
+        }
+        for (const auto& event : events) {
+            Client& client = clients[bySocket[event.socket]];
+            int received = recv(client.socket, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                poller.Remove(client.socket);
+                active--;
+                continue;
+            }
+            client.input.append(buffer, received);
+            size_t end = client.input.find('\n');
+            if (end == std::string::npos) {
+                continue;
+            }
+            if (client.input.compare(0, 3, "OK ") != 0) {
+                errors++;
+            }
+            client.input.erase(0, end + 1);
+            latencyUs.push_back(static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - client.sent).count()));
+            if (client.roundsLeft > 0) {
+                sendRequest(client);
+            }
+            else {
+                poller.Remove(client.socket);
+                active--;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (auto& client : clients) {
+        CloseSocket(client.socket);
+    }
+
+    long long jobs = static_cast<long long>(latencyUs.size()) * options.batch;
+    int maxLatency = latencyUs.empty() ? 0 : *std::max_element(latencyUs.begin(), latencyUs.end());
+    int p50 = Percentile(latencyUs, 50);
+    int p99 = Percentile(latencyUs, 99);
+    printf("serve-load: %zu connections, %zu requests, %lld jobs in %.2f s (%.0f jobs/s), %lld errors\n",
+        clients.size(), latencyUs.size(), jobs, seconds, seconds > 0 ? jobs / seconds : 0.0, errors);
+    printf("serve-load: request latency p50 %d us, p99 %d us, max %d us\n", p50, p99, maxLatency);
+    return errors == 0 && !latencyUs.empty() ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+
+#include "Scheduler.h"
+
+// Daemon mode: one live engine served over a line protocol.
+//
+//   SUBMIT <name> <burst>          -> OK <index> | DEFERRED <index> | REJECTED <index>
+//   BATCH <n>  + n "<name> <burst>" -> OK <firstIndex> <n> [deferred=.. rejected=..]
+//   STATE                          -> STATE now=.. running=.. ready=.. pending=.. completed=.. total=..
+//   STATS                          -> STATS switches=.. preemptions=.. switch_time=.. busy=.. late_us=.. ...
+//   TIMELINE <t> [max]             -> SEG <pid> <start> <length> ... END <count>
+//   AT <t>                         -> SEG <pid> <start> <length> | IDLE
+//   SLICES <pid> [max]             -> that process's SEG lines ... END <count>
+//   RANGE <from> <to> [max]        -> SEG lines overlapping [from, to) ... END <count>
+//   METRICS [JSON]                 -> hot-path counters (Prometheus text or JSON) ... END
+//   CHECKPOINT                     -> OK <bytes>, state queued for the checkpoint file
+//   QUIT / SHUTDOWN                -> closes the connection / stops the service
+//
+// DEFERRED and REJECTED are admission control's backpressure (see
+// AdmissionPolicy): the job waits for room, or will never run. Errors are
+// reported as "ERR <reason>". A client that half-closes its side still gets
+// answers to every request it sent, a last line without a newline
+// included, before the connection closes. Every connection is served from a
+// single readiness loop (epoll on Linux, WSAPoll on Windows) that also owns
+// the engine, so requests never contend on a lock.
+struct ServiceOptions {
+    unsigned short port = 7700;     // Localhost TCP port
+    std::string socketPath;         // UNIX domain socket instead of TCP (POSIX only)
+    double rate = 1000.0;           // Simulated time units per wall-clock second
+    SchedulerOptions scheduler;     // Ignored when resuming; the checkpoint has its own
+    std::string checkpointPath;     // Where CHECKPOINT and periodic checkpoints go
+    long long checkpointEvery = 0;  // Simulated time units between checkpoints; 0 = on request only
+    std::string resumePath;         // Checkpoint to continue from
+};
+
+// Blocks until a client sends SHUTDOWN. Returns a process exit code.
+int RunSchedulerService(const ServiceOptions& options);
+
+struct ServiceLoadOptions {
+    unsigned short port = 7700;
+    std::string socketPath;
+    int connections = 100;
+    int rounds = 100;               // Requests per connection
+    int batch = 16;                 // Jobs per BATCH request
+};
+
+// Stand-in producers: every connection streams BATCH requests and the
+// round-trip latency of each one is reported
+int RunServiceLoadTest(const ServiceLoadOptions& options);
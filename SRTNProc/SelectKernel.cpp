@@ -0,0 +1,194 @@
+#include "SelectKernel.h"
+
+#include <algorithm>
+#include <climits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define SRTN_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX code in functions that ask for it; MSVC always can
+#if defined(SRTN_X86) && !defined(_MSC_VER)
+#define SRTN_TARGET(features) __attribute__((target(features)))
+#else
+#define SRTN_TARGET(features)
+#endif
+
+int ArgminScalar(const int* values, size_t count) {
+    int best = -1;
+    int bestValue = INT_MAX;
+    for (size_t i = 0; i < count; i++) {
+        if (values[i] < bestValue) {
+            bestValue = values[i];
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+#ifdef SRTN_X86
+
+namespace {
+
+int LowestBit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long bit;
+    _BitScanForward(&bit, mask);
+    return static_cast<int>(bit);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Both kernels make two passes: a branch-free vector minimum, then a scan for
+// the first lane equal to it. The second pass usually stops early, and it is
+// what keeps the lowest-index tie-break exact. Below SCALAR_BELOW entries the
+// setup costs more than it saves.
+const size_t SCALAR_BELOW = 32;
+
+SRTN_TARGET("avx2")
+int ArgminAvx2(const int* values, size_t count) {
+    if (count < SCALAR_BELOW) {
+        return ArgminScalar(values, count);
+    }
+    size_t i = 0;
+    __m256i m0 = _mm256_set1_epi32(INT_MAX);
+    __m256i m1 = m0;
+    __m256i m2 = m0;
+    __m256i m3 = m0;
+    for (; i + 32 <= count; i += 32) {
+        m0 = _mm256_min_epi32(m0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+        m1 = _mm256_min_epi32(m1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 8)));
+        m2 = _mm256_min_epi32(m2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 16)));
+        m3 = _mm256_min_epi32(m3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 24)));
+    }
+    for (; i + 8 <= count; i += 8) {
+        m0 = _mm256_min_epi32(m0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+    }
+    __m256i m = _mm256_min_epi32(_mm256_min_epi32(m0, m1), _mm256_min_epi32(m2, m3));
+    __m128i half = _mm_min_epi32(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    int best = _mm_cvtsi128_si32(half);
+    for (; i < count; i++) {
+        best = std::min(best, values[i]);
+    }
+    if (best == INT_MAX) {
+        return -1;
+    }
+
+    __m256i target = _mm256_set1_epi32(best);
+    for (i = 0; i + 8 <= count; i += 8) {
+        __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)), target);
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+        if (mask != 0) {
+            return static_cast<int>(i) + LowestBit(mask);
+        }
+    }
+    for (; i < count; i++) {
+        if (values[i] == best) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// GCC 12 warns about the undefined passthrough inside its own AVX-512 headers
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+SRTN_TARGET("avx512f")
+int ArgminAvx512(const int* values, size_t count) {
+    if (count < SCALAR_BELOW) {
+        return ArgminScalar(values, count);
+    }
+    size_t i = 0;
+    __m512i m0 = _mm512_set1_epi32(INT_MAX);
+    __m512i m1 = m0;
+    for (; i + 32 <= count; i += 32) {
+        m0 = _mm512_min_epi32(m0, _mm512_loadu_si512(values + i));
+        m1 = _mm512_min_epi32(m1, _mm512_loadu_si512(values + i + 16));
+    }
+    // The tail is loaded under a mask, padding with INT_MAX
+    for (; i < count; i += 16) {
+        __mmask16 live = count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : static_cast<__mmask16>((1u << (count - i)) - 1);
+        m0 = _mm512_min_epi32(m0, _mm512_mask_loadu_epi32(_mm512_set1_epi32(INT_MAX), live, values + i));
+    }
+    int best = _mm512_reduce_min_epi32(_mm512_min_epi32(m0, m1));
+    if (best == INT_MAX) {
+        return -1;
+    }
+
+    __m512i target = _mm512_set1_epi32(best);
+    for (i = 0; i < count; i += 16) {
+        __mmask16 live = count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : static_cast<__mmask16>((1u << (count - i)) - 1);
+        __mmask16 equal = _mm512_mask_cmpeq_epi32_mask(live, _mm512_maskz_loadu_epi32(live, values + i), target);
+        if (equal != 0) {
+            return static_cast<int>(i) + LowestBit(equal);
+        }
+    }
+    return -1;
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+struct CpuFeatures {
+    bool avx2 = false;
+    bool avx512 = false;
+};
+
+CpuFeatures DetectCpu() {
+    CpuFeatures features;
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave) {
+        return features;
+    }
+    // The OS must save the YMM (and for AVX-512 the ZMM/opmask) state
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    features.avx2 = (xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0;
+    features.avx512 = (xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16)) != 0;
+#else
+    __builtin_cpu_init();
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.avx512 = __builtin_cpu_supports("avx512f");
+#endif
+    return features;
+}
+
+} // namespace
+
+#endif
+
+const std::vector<SelectKernel>& SelectKernels() {
+    static const std::vector<SelectKernel> kernels = []() {
+        std::vector<SelectKernel> list = { { "scalar", ArgminScalar } };
+#ifdef SRTN_X86
+        CpuFeatures cpu = DetectCpu();
+        if (cpu.avx2) {
+            list.push_back({ "avx2", ArgminAvx2 });
+        }
+        if (cpu.avx512) {
+            list.push_back({ "avx512", ArgminAvx512 });
+        }
+#endif
+        return list;
+    }();
+    return kernels;
+}
+
+const SelectKernel& BestSelectKernel() {
+    return SelectKernels().back();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Shortest-remaining selection over a contiguous array of remaining times.
+// Entries that must not be picked (completed, not yet arrived) hold INT_MAX.
+// Every kernel returns the lowest index holding the minimum, matching the
+// std::min_element tie-break, or -1 when every entry is INT_MAX.
+typedef int (*ArgminFn)(const int* values, size_t count);
+
+struct SelectKernel {
+    const char* name;
+    ArgminFn argmin;
+};
+
+int ArgminScalar(const int* values, size_t count);
+
+// Kernels this CPU can run, scalar first and the widest last
+const std::vector<SelectKernel>& SelectKernels();
+
+// The widest supported kernel, chosen once on first use
+const SelectKernel& BestSelectKernel();
+
+inline int Argmin(const int* values, size_t count) {
+    static const ArgminFn argmin = BestSelectKernel().argmin;
+    return argmin(values, count);
+}
@@ -0,0 +1,109 @@
+#include "SubmitQueue.h"
+
+#include <mutex>
+
+#include "Arena.h"
+
+// Each producer thread keeps a private free list. Drain hands a whole batch
+// back to the shared list with one CAS, and a producer that runs dry takes
+// that entire list with one exchange, so no thread pops single nodes off a
+// shared stack (and there is no ABA). The arena is only touched, in batches,
+// when both lists are empty.
+struct SubmitQueue::NodePool {
+    struct Cache {
+        Node* free = nullptr;
+
+        ~Cache() {
+            if (free != nullptr) {
+                Node* last = free;
+                while (last->next != nullptr) {
+                    last = last->next;
+                }
+                Pool().Release(free, last);
+            }
+        }
+    };
+
+    static const size_t BATCH = 64;
+
+    std::atomic<Node*> returned{ nullptr };
+    std::mutex arenaMutex;
+    MonotonicArena arena;
+
+    // Never destroyed: queues with static storage release their nodes at exit
+    static NodePool& Pool() {
+        static NodePool* pool = new NodePool();
+        return *pool;
+    }
+
+    Node* Allocate() {
+        thread_local Cache cache;
+        if (cache.free == nullptr) {
+            cache.free = returned.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (cache.free == nullptr) {
+            std::lock_guard<std::mutex> lock(arenaMutex);
+            Node* nodes = arena.Allocate<Node>(BATCH);
+            for (size_t i = 0; i < BATCH; i++) {
+                nodes[i].next = i + 1 < BATCH ? &nodes[i + 1] : nullptr;
+            }
+            cache.free = nodes;
+        }
+        Node* node = cache.free;
+        cache.free = node->next;
+        return node;
+    }
+
+    void Release(Node* first, Node* last) {
+        last->next = returned.load(std::memory_order_relaxed);
+        while (!returned.compare_exchange_weak(last->next, first,
+            std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+SubmitQueue::~SubmitQueue() {
+    Node* first = m_head.exchange(nullptr, std::memory_order_acquire);
+    if (first == nullptr) {
+        return;
+    }
+    Node* last = first;
+    while (last->next != nullptr) {
+        last = last->next;
+    }
+    NodePool::Pool().Release(first, last);
+}
+
+void SubmitQueue::Push(const Process& process) {
+    Node* node = NodePool::Pool().Allocate();
+    node->process = process;
+    node->next = m_head.load(std::memory_order_relaxed);
+    while (!m_head.compare_exchange_weak(node->next, node,
+        std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+size_t SubmitQueue::Drain(std::vector<Process>& out) {
+    if (Empty()) {
+        return 0;
+    }
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+    Node* newest = node;
+
+    // The stack holds newest first; reverse it to submission order
+    Node* oldest = nullptr;
+    while (node != nullptr) {
+        Node* next = node->next;
+        node->next = oldest;
+        oldest = node;
+        node = next;
+    }
+
+    size_t count = 0;
+    for (Node* at = oldest; at != nullptr; at = at->next) {
+        out.push_back(at->process);
+        count++;
+    }
+    NodePool::Pool().Release(oldest, newest);
+    return count;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "Process.h"
+
+// Lock-free multi-producer, single-consumer queue of new processes.
+// Producers push with one CAS and never block each other or the scheduler;
+// the scheduler takes the whole backlog with one exchange and restores FIFO order.
+// Nodes come from a shared pool and are recycled, so a steady stream of
+// submissions does not touch the heap.
+class SubmitQueue {
+public:
+    SubmitQueue() = default;
+    SubmitQueue(const SubmitQueue&) = delete;
+    SubmitQueue& operator=(const SubmitQueue&) = delete;
+    ~SubmitQueue();
+
+    // Safe to call from any thread
+    void Push(const Process& process);
+
+    // Consumer only: append everything pushed so far, oldest first.
+    // Returns the number of processes appended.
+    size_t Drain(std::vector<Process>& out);
+
+    bool Empty() const { return m_head.load(std::memory_order_relaxed) == nullptr; }
+
+private:
+    struct Node {
+        Process process;
+        Node* next;
+    };
+
+    struct NodePool;
+
+    std::atomic<Node*> m_head{ nullptr };
+};
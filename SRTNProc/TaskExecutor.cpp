@@ -0,0 +1,199 @@
+#include "TaskExecutor.h"
+
+#include <algorithm>
+
+namespace {
+
+// Lets a task that submits more work keep it on its own worker
+thread_local const TaskExecutor* t_executor = nullptr;
+thread_local size_t t_worker = 0;
+
+} // namespace
+
+TaskExecutor::TaskExecutor(int workers)
+    : m_queues(workers > 0 ? workers : std::max(1u, std::thread::hardware_concurrency())) {
+    for (size_t i = 0; i < m_queues.size(); i++) {
+        m_threads.emplace_back(&TaskExecutor::WorkerLoop, this, i);
+    }
+}
+
+TaskExecutor::~TaskExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void TaskExecutor::Submit(std::function<void()> work, long long estimatedCost) {
+    SubmitChunked([work](long long&) {
+        work();
+        return true;
+    }, estimatedCost);
+}
+
+void TaskExecutor::SubmitChunked(ChunkedTask step, long long estimatedCost) {
+    // LLONG_MAX marks an empty queue, so no task may carry it
+    Task* task = new Task{ std::move(step), std::min(std::max(estimatedCost, 0LL), LLONG_MAX - 1),
+        m_sequence.fetch_add(1, std::memory_order_relaxed) };
+    m_outstanding++;
+
+    size_t worker = t_executor == this ? t_worker
+        : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    Enqueue(task, worker);
+    m_queued++;
+
+    // Taking the lock orders the increment before any sleeper's re-check
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_wake.notify_one();
+}
+
+void TaskExecutor::WaitIdle() {
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_idle.wait(lock, [this]() { return m_outstanding == 0; });
+}
+
+TaskExecutor::Stats TaskExecutor::GetStats() const {
+    Stats stats;
+    stats.tasks = m_tasks;
+    stats.chunks = m_chunks;
+    stats.steals = m_steals;
+    stats.preemptions = m_preemptions;
+    return stats;
+}
+
+namespace {
+
+// Heap order: the cheapest task on top, oldest first among equals
+struct LaterTask {
+    template <typename T>
+    bool operator()(const T* a, const T* b) const {
+        if (a->remaining != b->remaining) {
+            return a->remaining > b->remaining;
+        }
+        return a->sequence > b->sequence;
+    }
+};
+
+} // namespace
+
+void TaskExecutor::Enqueue(Task* task, size_t worker) {
+    WorkerQueue& queue = m_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.heap.push_back(task);
+    std::push_heap(queue.heap.begin(), queue.heap.end(), LaterTask());
+    queue.minCost.store(queue.heap.front()->remaining, std::memory_order_relaxed);
+}
+
+// Cheapest task of the queue, provided it costs less than limit
+TaskExecutor::Task* TaskExecutor::PopBelow(WorkerQueue& queue, long long limit) {
+    if (queue.minCost.load(std::memory_order_relaxed) >= limit) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.heap.empty() || queue.heap.front()->remaining >= limit) {
+        return nullptr;
+    }
+    std::pop_heap(queue.heap.begin(), queue.heap.end(), LaterTask());
+    Task* task = queue.heap.back();
+    queue.heap.pop_back();
+    queue.minCost.store(queue.heap.empty() ? LLONG_MAX : queue.heap.front()->remaining, std::memory_order_relaxed);
+    return task;
+}
+
+// Take the cheapest task from whichever peer advertises it
+TaskExecutor::Task* TaskExecutor::Steal(size_t self) {
+    for (size_t attempt = 0; attempt < m_queues.size(); attempt++) {
+        size_t victim = self;
+        long long best = LLONG_MAX;
+        for (size_t i = 0; i < m_queues.size(); i++) {
+            long long cost = m_queues[i].minCost.load(std::memory_order_relaxed);
+            if (i != self && cost < best) {
+                best = cost;
+                victim = i;
+            }
+        }
+        if (victim == self) {
+            return nullptr;
+        }
+        if (Task* task = PopBelow(m_queues[victim], LLONG_MAX)) {
+            m_steals++;
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+// At a chunk boundary: if any queue holds something cheaper than what is
+// left of the running task, park the task on this worker and take that instead
+TaskExecutor::Task* TaskExecutor::Preempt(Task* task, size_t self) {
+    size_t best = self;
+    long long bestCost = task->remaining;
+    for (size_t i = 0; i < m_queues.size(); i++) {
+        long long cost = m_queues[i].minCost.load(std::memory_order_relaxed);
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = i;
+        }
+    }
+    if (bestCost >= task->remaining) {
+        return task;
+    }
+    Task* cheaper = PopBelow(m_queues[best], task->remaining);
+    if (cheaper == nullptr) {
+        return task;
+    }
+    Enqueue(task, self);
+    m_preemptions++;
+    if (best != self) {
+        m_steals++;
+    }
+    return cheaper;
+}
+
+void TaskExecutor::Finish(Task* task) {
+    delete task;
+    m_tasks++;
+    if (--m_outstanding == 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_idle.notify_all();
+    }
+}
+
+void TaskExecutor::WorkerLoop(size_t self) {
+    t_executor = this;
+    t_worker = self;
+
+    for (;;) {
+        Task* task = PopBelow(m_queues[self], LLONG_MAX);
+        if (task == nullptr) {
+            task = Steal(self);
+        }
+        if (task == nullptr) {
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            if (m_stopping && m_queued <= 0) {
+                return;
+            }
+            m_wake.wait(lock, [this]() { return m_queued > 0 || m_stopping; });
+            continue;
+        }
+        m_queued--;
+
+        // Preemption swaps one queued task for another, so m_queued is unchanged
+        while (task != nullptr) {
+            bool done = task->step(task->remaining);
+            m_chunks++;
+            if (done) {
+                Finish(task);
+                task = nullptr;
+            }
+            else {
+                task->remaining = std::min(std::max(task->remaining, 0LL), LLONG_MAX - 1);
+                task = Preempt(task, self);
+            }
+        }
+    }
+}
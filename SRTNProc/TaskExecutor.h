@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs callables on a worker pool in shortest-remaining-cost-first order.
+//
+// Each worker owns a min-heap of tasks keyed by estimated remaining cost.
+// Idle workers steal the cheapest task from the others, and a chunked task
+// yields its worker between chunks whenever a cheaper task is waiting, so
+// short requests never sit behind a long one for more than one chunk.
+class TaskExecutor {
+public:
+    // Runs one chunk of work. Update remainingCost with a fresh estimate and
+    // return true when the task is finished.
+    typedef std::function<bool(long long& remainingCost)> ChunkedTask;
+
+    struct Stats {
+        long long tasks = 0;
+        long long chunks = 0;
+        long long steals = 0;
+        long long preemptions = 0;  // Tasks put back at a chunk boundary for a cheaper one
+    };
+
+    explicit TaskExecutor(int workers = 0);     // 0 = one per hardware thread
+    ~TaskExecutor();                            // Finishes queued work, then joins
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    // Safe to call from any thread, including from inside a task
+    void Submit(std::function<void()> work, long long estimatedCost);
+    void SubmitChunked(ChunkedTask step, long long estimatedCost);
+
+    // Blocks until every submitted task has finished. Not for use inside a task.
+    void WaitIdle();
+
+    Stats GetStats() const;
+    int WorkerCount() const { return static_cast<int>(m_queues.size()); }
+
+private:
+    struct Task {
+        ChunkedTask step;
+        long long remaining;
+        uint64_t sequence;      // FIFO among equal costs
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::vector<Task*> heap;
+        std::atomic<long long> minCost{ LLONG_MAX };   // Peekable without the lock
+    };
+
+    void Enqueue(Task* task, size_t worker);
+    Task* PopBelow(WorkerQueue& queue, long long limit);
+    Task* Steal(size_t self);
+    Task* Preempt(Task* task, size_t self);
+    void Finish(Task* task);
+    void WorkerLoop(size_t self);
+
+    std::vector<WorkerQueue> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<uint64_t> m_sequence{ 0 };
+    std::atomic<size_t> m_nextQueue{ 0 };
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::atomic<long long> m_queued{ 0 };       // Tasks sitting in some heap
+    std::atomic<long long> m_outstanding{ 0 };  // Tasks submitted but not finished
+    bool m_stopping = false;
+
+    std::atomic<long long> m_tasks{ 0 };
+    std::atomic<long long> m_chunks{ 0 };
+    std::atomic<long long> m_steals{ 0 };
+    std::atomic<long long> m_preemptions{ 0 };
+};
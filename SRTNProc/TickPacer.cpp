@@ -0,0 +1,84 @@
+#include "TickPacer.h"
+
+#include <algorithm>
+#include <thread>
+
+TickPacer::TickPacer(std::chrono::nanoseconds period, int maxCatchUp)
+    : m_period(std::max(period, std::chrono::nanoseconds(1))), m_maxCatchUp(std::max(maxCatchUp, 0)) {
+    Start();
+}
+
+void TickPacer::Start(long long firstTick) {
+    m_start = Clock::now() - firstTick * m_period;
+    m_tick = firstTick;
+    m_stats = PacerStats();
+    std::fill(std::begin(m_buckets), std::end(m_buckets), 0);
+}
+
+long long TickPacer::WaitNextTick() {
+    long long tick = m_tick + 1;
+    Clock::time_point now = Clock::now();
+    if (now < Deadline(tick)) {
+        std::this_thread::sleep_until(Deadline(tick));
+        now = Clock::now();
+    }
+    else {
+        long long due = (now - m_start) / m_period;
+        if (due - tick > m_maxCatchUp) {
+            // Stalled for too long (suspend, debugger): resume from the present
+            m_stats.skipped += due - tick;
+            tick = due;
+        }
+        else if (due > tick) {
+            m_stats.caughtUp++;
+        }
+    }
+    Record(tick, now);
+    return tick;
+}
+
+long long TickPacer::DueTick() const {
+    return (Clock::now() - m_start) / m_period;
+}
+
+std::chrono::nanoseconds TickPacer::UntilNextTick() const {
+    Clock::time_point now = Clock::now();
+    long long next = (now - m_start) / m_period + 1;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Deadline(next) - now);
+}
+
+void TickPacer::Reached(long long tick) {
+    if (tick <= m_tick) {
+        return;
+    }
+    // Ticks passed over in one step were served late, all at once
+    m_stats.caughtUp += tick - m_tick - 1;
+    Record(tick, Clock::now());
+}
+
+void TickPacer::Record(long long tick, Clock::time_point now) {
+    m_tick = tick;
+    long long late = std::max<long long>(0,
+        std::chrono::duration_cast<std::chrono::microseconds>(now - Deadline(tick)).count());
+    m_stats.ticks++;
+    m_stats.lastLatenessMicros = late;
+    m_stats.totalLatenessMicros += late;
+    m_stats.maxLatenessMicros = std::max(m_stats.maxLatenessMicros, late);
+    m_buckets[MetricBucket(static_cast<uint64_t>(late))]++;
+    MetricObserve(Histogram::TickLatenessMicros, static_cast<uint64_t>(late));
+}
+
+long long TickPacer::LatenessPercentile(double percent) const {
+    if (m_stats.ticks == 0) {
+        return 0;
+    }
+    double rank = percent / 100.0 * m_stats.ticks;
+    uint64_t seen = 0;
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        seen += m_buckets[b];
+        if (seen >= rank && seen > 0) {
+            return b == 0 ? 0 : static_cast<long long>((uint64_t(1) << std::min(b, 62)) - 1);
+        }
+    }
+    return m_stats.maxLatenessMicros;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "Metrics.h"
+
+struct PacerStats {
+    long long ticks = 0;                // Ticks reached
+    long long caughtUp = 0;             // Ticks run back to back because the loop fell behind
+    long long skipped = 0;              // Ticks dropped to resynchronise after a long stall
+    long long maxLatenessMicros = 0;
+    long long totalLatenessMicros = 0;
+    long long lastLatenessMicros = 0;
+};
+
+// Real-time pacing from absolute deadlines. Tick n is due at start + n * period,
+// so time spent working and timer slop delay one tick but never accumulate
+// into drift. Lateness (wall time past a tick's deadline when it was reached)
+// is kept per pacer in a log2 histogram and fed to the TickLatenessMicros metric.
+class TickPacer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // Beyond maxCatchUp overdue ticks, WaitNextTick skips ahead instead of
+    // running the backlog back to back
+    explicit TickPacer(std::chrono::nanoseconds period, int maxCatchUp = 10);
+
+    // Restart the clock with firstTick due now, e.g. when resuming a checkpoint
+    void Start(long long firstTick = 0);
+
+    // Blocking loops: sleep until the next tick is due and return its number
+    long long WaitNextTick();
+
+    // Polling loops: the latest tick already due, the time until the one after
+    // it, and a report for each tick reached
+    long long DueTick() const;
+    std::chrono::nanoseconds UntilNextTick() const;
+    void Reached(long long tick);
+
+    std::chrono::nanoseconds Period() const { return m_period; }
+    const PacerStats& Stats() const { return m_stats; }
+    // Upper bound of the log2 bucket holding the given percentile
+    long long LatenessPercentile(double percent) const;
+
+private:
+    void Record(long long tick, Clock::time_point now);
+    Clock::time_point Deadline(long long tick) const { return m_start + m_period * tick; }
+
+    std::chrono::nanoseconds m_period;
+    int m_maxCatchUp;
+    Clock::time_point m_start;
+    long long m_tick = 0;
+    PacerStats m_stats;
+    uint64_t m_buckets[HISTOGRAM_BUCKETS] = {};
+};
@@ -0,0 +1,315 @@
+#include "TimelineFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char MAGIC[8] = { 'S', 'R', 'T', 'N', 'T', 'I', 'M', 'E' };
+const size_t HEADER_BYTES = sizeof(MAGIC) + sizeof(uint32_t);
+const size_t TRAILER_BYTES = 32;
+const size_t INDEX_ENTRY_BYTES = 24;
+
+void PutVarint(std::vector<unsigned char>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+// False past end or on a varint longer than 64 bits
+bool GetVarint(const unsigned char*& data, const unsigned char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && data < end; shift += 7) {
+        unsigned char byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t ZigZag(long long value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+long long UnZigZag(uint64_t value) {
+    return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+}
+
+template <typename T>
+void PutRaw(std::vector<unsigned char>& out, T value) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T GetRaw(const unsigned char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+// Timelines of long runs pass 2 GB
+bool SeekTo(FILE* file, uint64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+bool ReadAt(FILE* file, uint64_t offset, void* data, size_t size) {
+    return SeekTo(file, offset) && fread(data, 1, size, file) == size;
+}
+
+} // namespace
+
+TimelineWriter::~TimelineWriter() {
+    if (m_file != nullptr) {
+        fclose(m_file);
+    }
+}
+
+bool TimelineWriter::Open(const std::string& path, std::string& error) {
+    m_file = fopen(path.c_str(), "wb");
+    if (m_file == nullptr) {
+        error = "cannot create '" + path + "'";
+        return false;
+    }
+    // Blocks are written whole, so stdio's own buffer would only add a copy
+    setvbuf(m_file, nullptr, _IONBF, 0);
+    m_failed = false;
+    m_offset = 0;
+    m_segments = 0;
+    m_end = 0;
+    m_count = 0;
+    m_index.clear();
+    std::vector<unsigned char> header(MAGIC, MAGIC + sizeof(MAGIC));
+    PutRaw<uint32_t>(header, TIMELINE_FILE_VERSION);
+    Write(header.data(), header.size());
+    return true;
+}
+
+void TimelineWriter::Append(const TimelineRecord& record) {
+    long long process = record.processIndex;
+    long long start = record.startTime;
+    long long length = record.length;
+    if (m_count == 0) {
+        m_firstStart = start;
+        m_end = start;
+        m_previous = 0;
+    }
+    long long gap = start - m_end;
+    PutVarint(m_lengths, static_cast<uint64_t>(length) << 1 | (gap > 0 ? 1 : 0));
+    if (gap > 0) {
+        PutVarint(m_gaps, static_cast<uint64_t>(gap));
+    }
+    if (process < 0) {
+        m_processes.push_back(0);
+    }
+    else {
+        PutVarint(m_processes, ZigZag(process - m_previous) + 1);
+        m_previous = process;
+    }
+    m_end = start + length;
+    m_segments++;
+    if (++m_count == TIMELINE_BLOCK_SEGMENTS) {
+        Flush();
+    }
+}
+
+void TimelineWriter::Flush() {
+    if (m_count == 0) {
+        return;
+    }
+    m_index.push_back({ m_offset, m_firstStart, m_segments - m_count });
+    m_block.clear();
+    PutVarint(m_block, m_count);
+    PutVarint(m_block, static_cast<uint64_t>(m_firstStart));
+    PutVarint(m_block, m_lengths.size());
+    PutVarint(m_block, m_gaps.size());
+    PutVarint(m_block, m_processes.size());
+    m_block.insert(m_block.end(), m_lengths.begin(), m_lengths.end());
+    m_block.insert(m_block.end(), m_gaps.begin(), m_gaps.end());
+    m_block.insert(m_block.end(), m_processes.begin(), m_processes.end());
+    Write(m_block.data(), m_block.size());
+    m_lengths.clear();
+    m_gaps.clear();
+    m_processes.clear();
+    m_count = 0;
+}
+
+void TimelineWriter::Write(const void* data, size_t size) {
+    if (!m_failed && fwrite(data, 1, size, m_file) != size) {
+        m_failed = true;
+    }
+    m_offset += size;
+}
+
+bool TimelineWriter::Close(std::string& error) {
+    if (m_file == nullptr) {
+        error = "not open";
+        return false;
+    }
+    long long end = m_end;
+    Flush();
+    m_block.clear();
+    uint64_t indexOffset = m_offset;
+    for (const auto& entry : m_index) {
+        PutRaw<uint64_t>(m_block, entry.offset);
+        PutRaw<int64_t>(m_block, entry.firstStart);
+        PutRaw<uint64_t>(m_block, entry.segmentsBefore);
+    }
+    PutRaw<uint64_t>(m_block, indexOffset);
+    PutRaw<uint64_t>(m_block, m_index.size());
+    PutRaw<uint64_t>(m_block, m_segments);
+    PutRaw<int64_t>(m_block, m_segments > 0 ? end : 0);
+    Write(m_block.data(), m_block.size());
+    bool ok = fclose(m_file) == 0 && !m_failed;
+    m_file = nullptr;
+    if (!ok) {
+        error = "cannot write the timeline";
+    }
+    return ok;
+}
+
+TimelineReader::~TimelineReader() {
+    if (m_file != nullptr) {
+        fclose(m_file);
+    }
+}
+
+bool TimelineReader::Open(const std::string& path, std::string& error) {
+    m_path = path;
+    m_file = fopen(path.c_str(), "rb");
+    if (m_file == nullptr) {
+        error = "cannot open '" + path + "'";
+        return false;
+    }
+    unsigned char header[HEADER_BYTES];
+    if (fread(header, 1, sizeof(header), m_file) != sizeof(header) || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "'" + path + "' is not a timeline file";
+        return false;
+    }
+    uint32_t version = GetRaw<uint32_t>(header + sizeof(MAGIC));
+    if (version != TIMELINE_FILE_VERSION) {
+        error = "unsupported timeline version " + std::to_string(version);
+        return false;
+    }
+
+    unsigned char trailer[TRAILER_BYTES];
+#ifdef _WIN32
+    bool found = _fseeki64(m_file, -static_cast<long long>(TRAILER_BYTES), SEEK_END) == 0;
+#else
+    bool found = fseeko(m_file, -static_cast<off_t>(TRAILER_BYTES), SEEK_END) == 0;
+#endif
+    if (!found || fread(trailer, 1, sizeof(trailer), m_file) != sizeof(trailer)) {
+        error = "'" + path + "' is truncated";
+        return false;
+    }
+    m_indexOffset = GetRaw<uint64_t>(trailer);
+    uint64_t blocks = GetRaw<uint64_t>(trailer + 8);
+    m_segments = GetRaw<uint64_t>(trailer + 16);
+    m_end = GetRaw<int64_t>(trailer + 24);
+    if (blocks > m_segments || m_indexOffset < HEADER_BYTES) {
+        error = "'" + path + "' has a damaged trailer";
+        return false;
+    }
+    std::vector<unsigned char> index(blocks * INDEX_ENTRY_BYTES);
+    if (!ReadAt(m_file, m_indexOffset, index.data(), index.size())) {
+        error = "'" + path + "' has a damaged index";
+        return false;
+    }
+    m_index.resize(blocks);
+    for (size_t i = 0; i < blocks; i++) {
+        const unsigned char* entry = index.data() + i * INDEX_ENTRY_BYTES;
+        m_index[i] = { GetRaw<uint64_t>(entry), GetRaw<int64_t>(entry + 8), GetRaw<uint64_t>(entry + 16) };
+    }
+    m_block = 0;
+    m_records.clear();
+    m_position = 0;
+    m_loaded = false;
+    return true;
+}
+
+bool TimelineReader::LoadBlock(size_t block, std::string& error) {
+    m_block = block;
+    m_records.clear();
+    m_position = 0;
+    m_loaded = true;
+    if (block >= m_index.size()) {
+        return true;
+    }
+    uint64_t offset = m_index[block].offset;
+    uint64_t next = block + 1 < m_index.size() ? m_index[block + 1].offset : m_indexOffset;
+    std::vector<unsigned char> bytes(next > offset ? next - offset : 0);
+    if (bytes.empty() || !ReadAt(m_file, offset, bytes.data(), bytes.size())) {
+        error = "cannot read block " + std::to_string(block) + " of '" + m_path + "'";
+        return false;
+    }
+
+    const unsigned char* data = bytes.data();
+    const unsigned char* end = data + bytes.size();
+    uint64_t count, firstStart, lengthsBytes, gapsBytes, processesBytes;
+    bool ok = GetVarint(data, end, count) && GetVarint(data, end, firstStart) &&
+        GetVarint(data, end, lengthsBytes) && GetVarint(data, end, gapsBytes) && GetVarint(data, end, processesBytes) &&
+        count <= TIMELINE_BLOCK_SEGMENTS && lengthsBytes + gapsBytes + processesBytes == static_cast<uint64_t>(end - data);
+    const unsigned char* lengths = data;
+    const unsigned char* gaps = lengths + (ok ? lengthsBytes : 0);
+    const unsigned char* processes = gaps + (ok ? gapsBytes : 0);
+    long long time = static_cast<long long>(firstStart);
+    long long previous = 0;
+    m_records.reserve(static_cast<size_t>(ok ? count : 0));
+    for (uint64_t i = 0; ok && i < count; i++) {
+        uint64_t length, code;
+        ok = GetVarint(lengths, gaps, length) && GetVarint(processes, end, code);
+        if (ok && (length & 1) != 0) {
+            uint64_t gap;
+            ok = GetVarint(gaps, processes, gap);
+            time += static_cast<long long>(gap);
+        }
+        if (ok) {
+            long long process = code == 0 ? -1 : (previous += UnZigZag(code - 1));
+            m_records.push_back({ process, time, static_cast<long long>(length >> 1) });
+            time += static_cast<long long>(length >> 1);
+        }
+    }
+    if (!ok) {
+        m_records.clear();
+        error = "block " + std::to_string(block) + " of '" + m_path + "' is damaged";
+        return false;
+    }
+    return true;
+}
+
+bool TimelineReader::Seek(long long t, std::string& error) {
+    // The last block starting at or before t holds the segment covering t, or
+    // else the first one after it starts the next block
+    auto after = std::upper_bound(m_index.begin(), m_index.end(), t,
+        [](long long time, const BlockEntry& entry) { return time < entry.firstStart; });
+    size_t block = after == m_index.begin() ? 0 : static_cast<size_t>(after - m_index.begin()) - 1;
+    if (!LoadBlock(block, error)) {
+        return false;
+    }
+    auto first = std::partition_point(m_records.begin(), m_records.end(),
+        [t](const TimelineRecord& record) { return record.startTime + record.length <= t; });
+    m_position = static_cast<size_t>(first - m_records.begin());
+    return true;
+}
+
+bool TimelineReader::Next(TimelineRecord& record, std::string& error) {
+    if (!m_loaded && !LoadBlock(m_block, error)) {
+        return false;
+    }
+    while (m_position == m_records.size()) {
+        if (m_block + 1 >= m_index.size() || !LoadBlock(m_block + 1, error)) {
+            return false;
+        }
+    }
+    record = m_records[m_position++];
+    return true;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Process.h"
+
+// Run timelines on disk, a few bytes per segment:
+//
+//   "SRTNTIME" version:u32 block* index trailer
+//
+// Each block holds up to TIMELINE_BLOCK_SEGMENTS segments as three columns of
+// LEB128 varints, each column prefixed by its byte length:
+//
+//   count firstStart lengthsBytes gapsBytes processesBytes
+//   lengths:    length << 1 | 1 if idle time came before the segment
+//   gaps:       that idle time, only for the segments flagged in lengths
+//   processes:  0 for a context switch, else zigzag(process - previous) + 1,
+//               previous being the block's last process (0 at its start)
+//
+// so a start time is the previous segment's end plus its gap, and a block
+// decodes without the ones before it. The index holds, per block, its file
+// offset, first start and the segments before it, as fixed-width numbers; the
+// 32-byte trailer holds the index offset, block count, segment count and end
+// time. Numbers outside the varints are little-endian.
+const uint32_t TIMELINE_FILE_VERSION = 1;
+const size_t TIMELINE_BLOCK_SEGMENTS = 65536;
+
+// Processes are widened to long long, with -1 for context switches
+typedef BasicRunSegment<long long, long long> TimelineRecord;
+
+// An engine segment as stored, the engine's NO_PROCESS becoming -1
+template <typename Time, typename Index>
+TimelineRecord ToRecord(const BasicRunSegment<Time, Index>& segment) {
+    return { segment.processIndex == static_cast<Index>(-1) ? -1 : static_cast<long long>(segment.processIndex),
+        static_cast<long long>(segment.startTime), static_cast<long long>(segment.length) };
+}
+
+// Streams segments to a file, one block in memory at a time
+class TimelineWriter {
+public:
+    TimelineWriter() = default;
+    // Closes the file; call Close to learn whether everything was written
+    ~TimelineWriter();
+    TimelineWriter(const TimelineWriter&) = delete;
+    TimelineWriter& operator=(const TimelineWriter&) = delete;
+
+    bool Open(const std::string& path, std::string& error);
+    // Segments must come in time order without overlapping
+    void Append(const TimelineRecord& record);
+    // Writes the last block, the index and the trailer
+    bool Close(std::string& error);
+
+    uint64_t SegmentCount() const { return m_segments; }
+    // Bytes written so far, the block in memory excluded
+    uint64_t BytesWritten() const { return m_offset; }
+
+private:
+    struct BlockEntry {
+        uint64_t offset;
+        int64_t firstStart;
+        uint64_t segmentsBefore;
+    };
+
+    void Flush();
+    void Write(const void* data, size_t size);
+
+    FILE* m_file = nullptr;
+    bool m_failed = false;
+    uint64_t m_offset = 0;
+    uint64_t m_segments = 0;
+    long long m_end = 0;
+    long long m_previous = 0;
+    size_t m_count = 0;                 // Segments in the block being built
+    long long m_firstStart = 0;
+    std::vector<unsigned char> m_lengths;
+    std::vector<unsigned char> m_gaps;
+    std::vector<unsigned char> m_processes;
+    std::vector<unsigned char> m_block;
+    std::vector<BlockEntry> m_index;
+};
+
+// Reads a timeline file forwards from any time, decoding one block at a time,
+// so memory stays at one block plus the index however long the run was
+class TimelineReader {
+public:
+    TimelineReader() = default;
+    ~TimelineReader();
+    TimelineReader(const TimelineReader&) = delete;
+    TimelineReader& operator=(const TimelineReader&) = delete;
+
+    // Reads the trailer and index; the reader starts at the first segment
+    bool Open(const std::string& path, std::string& error);
+
+    uint64_t SegmentCount() const { return m_segments; }
+    size_t BlockCount() const { return m_index.size(); }
+    // End of the last segment; 0 when empty
+    long long End() const { return m_end; }
+
+    // Move to the first segment that ends after t, by binary search over the
+    // block index and a scan of one block
+    bool Seek(long long t, std::string& error);
+    // The next segment; false at the end, or with error set if the file is damaged
+    bool Next(TimelineRecord& record, std::string& error);
+
+private:
+    struct BlockEntry {
+        uint64_t offset;
+        int64_t firstStart;
+        uint64_t segmentsBefore;
+    };
+
+    bool LoadBlock(size_t block, std::string& error);
+
+    FILE* m_file = nullptr;
+    std::string m_path;
+    uint64_t m_segments = 0;
+    long long m_end = 0;
+    uint64_t m_indexOffset = 0;
+    std::vector<BlockEntry> m_index;
+    // The decoded block and the reader's place in it
+    size_t m_block = 0;
+    bool m_loaded = false;
+    std::vector<TimelineRecord> m_records;
+    size_t m_position = 0;
+};
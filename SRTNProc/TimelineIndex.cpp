@@ -0,0 +1,111 @@
+#include "TimelineIndex.h"
+
+#include <algorithm>
+
+template <typename Time, typename Index>
+void BasicTimelineIndex<Time, Index>::Clear() {
+    m_segments.clear();
+    m_starts.clear();
+    m_next.clear();
+    m_first.clear();
+    m_last.clear();
+    m_count.clear();
+}
+
+template <typename Time, typename Index>
+void BasicTimelineIndex<Time, Index>::Update(const std::vector<Segment>& timeline) {
+    if (timeline.size() < m_segments.size()) {
+        Clear();
+    }
+    if (!m_segments.empty()) {
+        // The engine extends its last segment in place
+        m_segments.back().length = timeline[m_segments.size() - 1].length;
+    }
+    for (size_t i = m_segments.size(); i < timeline.size(); i++) {
+        Add(timeline[i]);
+    }
+}
+
+template <typename Time, typename Index>
+void BasicTimelineIndex<Time, Index>::Add(const Segment& segment) {
+    size_t position = m_segments.size();
+    m_segments.push_back(segment);
+    m_starts.push_back(segment.startTime);
+    m_next.push_back(NONE);
+    if (segment.processIndex == NO_PROCESS) {
+        return;
+    }
+    size_t process = static_cast<size_t>(segment.processIndex);
+    if (process >= m_first.size()) {
+        m_first.resize(process + 1, NONE);
+        m_last.resize(process + 1, NONE);
+        m_count.resize(process + 1, 0);
+    }
+    if (m_last[process] == NONE) {
+        m_first[process] = position;
+    }
+    else {
+        m_next[m_last[process]] = position;
+    }
+    m_last[process] = position;
+    m_count[process]++;
+}
+
+template <typename Time, typename Index>
+Time BasicTimelineIndex<Time, Index>::End() const {
+    return m_segments.empty() ? 0 : m_segments.back().startTime + m_segments.back().length;
+}
+
+template <typename Time, typename Index>
+size_t BasicTimelineIndex<Time, Index>::At(Time t) const {
+    size_t after = std::upper_bound(m_starts.begin(), m_starts.end(), t) - m_starts.begin();
+    if (after == 0) {
+        return NONE;
+    }
+    const Segment& segment = m_segments[after - 1];
+    return t < segment.startTime + segment.length ? after - 1 : NONE;
+}
+
+template <typename Time, typename Index>
+void BasicTimelineIndex<Time, Index>::SlicesOf(Index process, std::vector<Segment>& out, size_t limit) const {
+    if (process == NO_PROCESS || static_cast<size_t>(process) >= m_first.size()) {
+        return;
+    }
+    for (size_t position = m_first[process]; position != NONE && limit > 0; position = m_next[position], limit--) {
+        out.push_back(m_segments[position]);
+    }
+}
+
+template <typename Time, typename Index>
+size_t BasicTimelineIndex<Time, Index>::SliceCount(Index process) const {
+    if (process == NO_PROCESS || static_cast<size_t>(process) >= m_count.size()) {
+        return 0;
+    }
+    return m_count[process];
+}
+
+template <typename Time, typename Index>
+void BasicTimelineIndex<Time, Index>::Overlapping(Time from, Time to, std::vector<Segment>& out, size_t limit) const {
+    // Segments are disjoint and in time order: start from the one covering
+    // from, if any, else the first one after it
+    size_t position = std::upper_bound(m_starts.begin(), m_starts.end(), from) - m_starts.begin();
+    if (position > 0 && from < m_segments[position - 1].startTime + m_segments[position - 1].length) {
+        position--;
+    }
+    for (; position < m_segments.size() && m_starts[position] < to && limit > 0; position++, limit--) {
+        out.push_back(m_segments[position]);
+    }
+}
+
+template <typename Time, typename Index>
+size_t BasicTimelineIndex<Time, Index>::MemoryUsage() const {
+    return m_segments.capacity() * sizeof(Segment) +
+        m_starts.capacity() * sizeof(Time) +
+        (m_next.capacity() + m_first.capacity() + m_last.capacity() + m_count.capacity()) * sizeof(size_t);
+}
+
+template class BasicTimelineIndex<int, int>;
+template class BasicTimelineIndex<int32_t, uint16_t>;
+template class BasicTimelineIndex<int32_t, uint32_t>;
+template class BasicTimelineIndex<int64_t, uint16_t>;
+template class BasicTimelineIndex<int64_t, uint32_t>;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Process.h"
+
+// Query index over a run's timeline: the segment running at a given time,
+// every slice of one process, and the segments overlapping an interval, each
+// in O(log n + k) for k results. Start times are kept in their own sorted
+// array for the binary search, and each process's slices are chained through
+// a next-slice array, so the index grows by appending as the timeline does
+// and never re-sorts. Context switches (NO_PROCESS) are found by time but
+// belong to no process. The members are defined in TimelineIndex.cpp and
+// instantiated there for every engine width pair.
+template <typename Time, typename Index>
+class BasicTimelineIndex {
+public:
+    typedef BasicRunSegment<Time, Index> Segment;
+
+    static constexpr Index NO_PROCESS = static_cast<Index>(-1);
+    static constexpr size_t NONE = SIZE_MAX;
+
+    // Index what the timeline gained since the last update. An engine's
+    // timeline only grows at the end, and its last segment may have been
+    // extended meanwhile; one that shrank is indexed from scratch. After an
+    // engine Reset or Rewind, Clear first.
+    void Update(const std::vector<Segment>& timeline);
+    void Clear();
+
+    size_t Size() const { return m_segments.size(); }
+    const Segment& SegmentAt(size_t position) const { return m_segments[position]; }
+    // End of the last segment; 0 when empty
+    Time End() const;
+
+    // Position of the segment covering time t, or NONE if the CPU was idle
+    size_t At(Time t) const;
+    // Append up to limit of the process's segments to out, in time order
+    void SlicesOf(Index process, std::vector<Segment>& out, size_t limit = NONE) const;
+    size_t SliceCount(Index process) const;
+    // Append up to limit of the segments overlapping [from, to), in time order
+    void Overlapping(Time from, Time to, std::vector<Segment>& out, size_t limit = NONE) const;
+
+    size_t MemoryUsage() const;
+
+private:
+    void Add(const Segment& segment);
+
+    std::vector<Segment> m_segments;
+    std::vector<Time> m_starts;     // m_segments[i].startTime, for the search
+    std::vector<size_t> m_next;     // Next segment of the same process; NONE at the last
+    std::vector<size_t> m_first;    // By process: first and last segment, NONE if it never ran
+    std::vector<size_t> m_last;
+    std::vector<size_t> m_count;
+};
+
+typedef BasicTimelineIndex<int, int> TimelineIndex;
@@ -0,0 +1,427 @@
+#include "TraceFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Smaller pieces are not worth a thread
+const size_t MIN_CHUNK_BYTES = 1 << 20;
+// More digits than this could overflow int64_t
+const ptrdiff_t MAX_DIGITS = 18;
+// Slots in each worker's name cache; a power of two
+const size_t NAME_SLOTS = 4096;
+// SaveTrace writes in pieces of about this size
+const size_t WRITE_BUFFER = 1 << 20;
+
+// Read-only mapping of a whole file
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    const char* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = NULL;
+#endif
+};
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::string& path) {
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    LARGE_INTEGER size;
+    if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size)) {
+        return false;
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size == 0) {
+        return true;    // An empty file cannot be mapped, and need not be
+    }
+    m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_mapping == NULL) {
+        return false;
+    }
+    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    return m_data != nullptr;
+}
+
+MappedFile::~MappedFile() {
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != NULL) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+    }
+}
+#else
+bool MappedFile::Open(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    bool ok = fstat(fd, &info) == 0;
+    m_size = ok ? static_cast<size_t>(info.st_size) : 0;
+    if (ok && m_size > 0) {
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ok = data != MAP_FAILED;
+        if (ok) {
+            m_data = static_cast<const char*>(data);
+            // Every worker reads its chunk front to back
+            madvise(data, m_size, MADV_SEQUENTIAL);
+        }
+    }
+    close(fd);      // The mapping holds its own reference
+    return ok;
+}
+
+MappedFile::~MappedFile() {
+    if (m_data != nullptr) {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+}
+#endif
+
+struct Chunk {
+    const char* begin;
+    const char* end;
+    size_t first = 0;           // Where its processes go in the workload
+    size_t lines = 0;           // Room reserved for them: one per line end, plus an unterminated last line
+    size_t parsed = 0;
+    const char* bad = nullptr;  // First line that did not parse
+    bool sorted = true;         // Arrivals non-decreasing within the chunk
+};
+
+// Worker-local map from a name's bytes in the mapping to its id, so the
+// shared table's lock is taken once per name per worker rather than per line.
+// Direct-mapped: a collision only costs another Intern.
+class NameCache {
+public:
+    NameCache() : m_slots(NAME_SLOTS) {}
+
+    NameId Lookup(const char* text, size_t length, uint32_t hash) {
+        Slot& slot = m_slots[hash & (NAME_SLOTS - 1)];
+        if (slot.length == length && std::memcmp(slot.text, text, length) == 0) {
+            return slot.id;
+        }
+        m_wide.resize(length);
+        for (size_t i = 0; i < length; i++) {
+            m_wide[i] = static_cast<unsigned char>(text[i]);
+        }
+        slot = { text, length, ProcessNames().Intern(m_wide) };
+        return slot.id;
+    }
+
+private:
+    struct Slot {
+        const char* text = nullptr;
+        size_t length = 0;
+        NameId id = EMPTY_NAME;
+    };
+
+    std::vector<Slot> m_slots;
+    std::wstring m_wide;
+};
+
+// Decimal digits up to the first other byte, with one compare per digit and
+// no locale. False if there are none, or too many to fit.
+bool ParseNumber(const char*& p, const char* end, int64_t& value) {
+    const char* start = p;
+    uint64_t number = 0;
+    unsigned digit;
+    while (p < end && (digit = static_cast<unsigned char>(*p) - '0') < 10) {
+        number = number * 10 + digit;
+        p++;
+    }
+    value = static_cast<int64_t>(number);
+    return p != start && p - start <= MAX_DIGITS;
+}
+
+// Parse a chunk's lines in one pass, straight into out
+void ParseChunk(Chunk& chunk, BasicProcess<int64_t>* out) {
+    NameCache names;
+    int64_t last = 0;
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+    while (p < end) {
+        const char* line = p;
+        if (*p == '\r') {
+            p++;
+        }
+        if (p < end && *p == '\n') {
+            p++;
+            continue;
+        }
+
+        int64_t arrival;
+        int64_t burst;
+        if (!ParseNumber(p, end, arrival) || p == end || *p++ != ',' || !ParseNumber(p, end, burst)) {
+            chunk.bad = line;
+            return;
+        }
+        NameId name = EMPTY_NAME;
+        if (p < end && *p == ',') {
+            const char* text = ++p;
+            uint32_t hash = 2166136261u;
+            while (p < end && *p != '\n' && *p != '\r') {
+                hash = (hash ^ static_cast<unsigned char>(*p)) * 16777619u;
+                p++;
+            }
+            if (p > text) {
+                name = names.Lookup(text, p - text, hash);
+            }
+        }
+        if (p < end && *p == '\r') {
+            p++;
+        }
+        if (p < end && *p++ != '\n') {
+            chunk.bad = line;
+            return;
+        }
+
+        chunk.sorted = chunk.sorted && arrival >= last;
+        last = arrival;
+        out[chunk.parsed++] = { name, burst, burst, arrival, 0, 0, false };
+    }
+}
+
+// fn(i) for i below count, one thread each, the caller's thread included
+template <typename Fn>
+void InParallel(size_t count, Fn fn) {
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < count; i++) {
+        pool.emplace_back(fn, i);
+    }
+    if (count > 0) {
+        fn(0);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+bool LoadTrace(const std::string& path, int threads, Workload& workload, TraceLoadStats& stats, std::string& error) {
+    stats = TraceLoadStats();
+    auto start = std::chrono::steady_clock::now();
+    MappedFile file;
+    if (!file.Open(path)) {
+        error = "cannot read '" + path + "'";
+        return false;
+    }
+    stats.bytes = file.Size();
+    stats.mapSeconds = SecondsSince(start);
+
+    const char* data = file.Data();
+    const char* begin = data;
+    const char* end = data + file.Size();
+    if (file.Size() >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0) {
+        begin += 3;
+    }
+    if (begin < end && static_cast<unsigned>(static_cast<unsigned char>(*begin) - '0') >= 10) {
+        const char* eol = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        begin = eol != nullptr ? eol + 1 : end;
+    }
+
+    // Cut at the first line end after each even split point
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    size_t count = std::max<size_t>(1, std::min<size_t>(threads, (end - begin) / MIN_CHUNK_BYTES));
+    std::vector<Chunk> chunks(count);
+    const char* cut = begin;
+    for (size_t c = 0; c < count; c++) {
+        chunks[c].begin = cut;
+        if (c + 1 < count) {
+            const char* split = std::max(cut, begin + static_cast<size_t>(end - begin) / count * (c + 1));
+            const char* eol = static_cast<const char*>(std::memchr(split, '\n', end - split));
+            cut = eol != nullptr ? eol + 1 : end;
+        }
+        else {
+            cut = end;
+        }
+        chunks[c].end = cut;
+    }
+    stats.chunks = static_cast<int>(count);
+
+    // Count line ends first, so every chunk can parse into its final place
+    start = std::chrono::steady_clock::now();
+    InParallel(count, [&chunks](size_t c) {
+        Chunk& chunk = chunks[c];
+        chunk.lines = std::count(chunk.begin, chunk.end, '\n');
+        if (chunk.end > chunk.begin && chunk.end[-1] != '\n') {
+            chunk.lines++;
+        }
+    });
+    size_t room = 0;
+    for (Chunk& chunk : chunks) {
+        chunk.first = room;
+        room += chunk.lines;
+    }
+    workload.processes.resize(room);
+    BasicProcess<int64_t>* processes = workload.processes.data();
+    InParallel(count, [&chunks, processes](size_t c) { ParseChunk(chunks[c], processes + chunks[c].first); });
+    stats.parseSeconds = SecondsSince(start);
+    for (const Chunk& chunk : chunks) {
+        if (chunk.bad != nullptr) {
+            size_t line = 1 + std::count(data, chunk.bad, '\n');
+            error = path + ": line " + std::to_string(line) + ": expected arrival,burst[,name]";
+            return false;
+        }
+    }
+
+    // Close the gaps blank lines left, and note where each chunk's run starts
+    start = std::chrono::steady_clock::now();
+    std::vector<size_t> runs;
+    size_t total = 0;
+    int64_t last = 0;
+    for (const Chunk& chunk : chunks) {
+        if (chunk.parsed == 0) {
+            continue;
+        }
+        if (chunk.first != total) {
+            std::copy(processes + chunk.first, processes + chunk.first + chunk.parsed, processes + total);
+        }
+        stats.sorted = stats.sorted && chunk.sorted && processes[total].appearingTime >= last;
+        runs.push_back(total);
+        total += chunk.parsed;
+        last = processes[total - 1].appearingTime;
+    }
+    runs.push_back(total);
+    workload.processes.resize(total);
+    stats.processes = total;
+
+    if (!stats.sorted) {
+        // Sort (arrival, line) keys rather than whole processes: each run in
+        // parallel, then neighbouring runs merged pairwise, in parallel,
+        // until one is left. The line number keeps ties in file order.
+        std::vector<std::pair<int64_t, size_t>> keys(total);
+        std::pair<int64_t, size_t>* key = keys.data();
+        InParallel(runs.size() - 1, [&runs, processes, key](size_t r) {
+            for (size_t i = runs[r]; i < runs[r + 1]; i++) {
+                key[i] = { processes[i].appearingTime, i };
+            }
+            std::sort(key + runs[r], key + runs[r + 1]);
+        });
+        while (runs.size() > 2) {
+            InParallel((runs.size() - 1) / 2, [&runs, key](size_t pair) {
+                std::inplace_merge(key + runs[2 * pair], key + runs[2 * pair + 1], key + runs[2 * pair + 2]);
+            });
+            std::vector<size_t> merged;
+            for (size_t r = 0; r + 1 < runs.size(); r += 2) {
+                merged.push_back(runs[r]);
+            }
+            merged.push_back(total);
+            runs.swap(merged);
+        }
+        std::vector<BasicProcess<int64_t>> ordered(total);
+        BasicProcess<int64_t>* to = ordered.data();
+        InParallel(count, [total, count, processes, key, to](size_t c) {
+            for (size_t i = total * c / count; i < total * (c + 1) / count; i++) {
+                to[i] = processes[key[i].second];
+            }
+        });
+        workload.processes.swap(ordered);
+        processes = workload.processes.data();
+    }
+
+    workload.arrivalTimes.resize(total);
+    int64_t* arrivals = workload.arrivalTimes.data();
+    InParallel(count, [total, count, processes, arrivals](size_t c) {
+        for (size_t i = total * c / count; i < total * (c + 1) / count; i++) {
+            arrivals[i] = processes[i].appearingTime;
+        }
+    });
+    workload.bursts.clear();
+    workload.firstBurst.clear();
+    workload.groups.clear();
+    workload.deadlines.clear();
+    stats.mergeSeconds = SecondsSince(start);
+    return true;
+}
+
+bool SaveTrace(const std::string& path, const Workload& workload, std::string& error) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        error = "cannot create '" + path + "'";
+        return false;
+    }
+
+    // Names narrowed once per id, not once per line
+    std::vector<std::string> names;
+    std::vector<char> out;
+    out.reserve(WRITE_BUFFER + 4096);
+    const char header[] = "arrival,burst,name\n";
+    out.insert(out.end(), header, header + sizeof(header) - 1);
+    bool ok = true;
+    for (size_t i = 0; i < workload.processes.size() && ok; i++) {
+        const auto& process = workload.processes[i];
+        // Room for two 20-character numbers and the comma between them
+        char number[48];
+        char* last = std::to_chars(number, number + 20, workload.arrivalTimes[i]).ptr;
+        *last++ = ',';
+        last = std::to_chars(last, number + sizeof(number), process.burstTime).ptr;
+        out.insert(out.end(), number, last);
+
+        if (process.name != EMPTY_NAME) {
+            if (process.name >= names.size()) {
+                names.resize(process.name + 1);
+            }
+            std::string& name = names[process.name];
+            if (name.empty()) {
+                std::wstring_view text = ProcessNames().View(process.name);
+                name.push_back(',');
+                for (wchar_t ch : text) {
+                    name.push_back(static_cast<char>(ch));
+                }
+            }
+            out.insert(out.end(), name.begin(), name.end());
+        }
+        out.push_back('\n');
+        if (out.size() >= WRITE_BUFFER) {
+            ok = fwrite(out.data(), 1, out.size(), file) == out.size();
+            out.clear();
+        }
+    }
+    ok = ok && fwrite(out.data(), 1, out.size(), file) == out.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        error = "cannot write '" + path + "'";
+    }
+    return ok;
+}
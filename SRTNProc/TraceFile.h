@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "Workload.h"
+
+// Workload traces are CSV text, one process per line:
+//
+//   arrival,burst[,name]
+//
+// with non-negative decimal integers and a name running to the end of the
+// line (commas included, no quoting). A first line that does not start with
+// a digit is a header and is skipped; blank lines and CRLF endings are fine.
+// Names are read as bytes, one character each, like Narrow in Headless.cpp.
+
+struct TraceLoadStats {
+    size_t bytes = 0;
+    size_t processes = 0;
+    int chunks = 0;             // Pieces parsed in parallel
+    bool sorted = true;         // Lines were already in arrival order
+    double mapSeconds = 0;
+    double parseSeconds = 0;
+    double mergeSeconds = 0;
+};
+
+// Map the file, split it at line boundaries into one chunk per thread (0 =
+// one per hardware thread; small files get fewer), parse the chunks in
+// parallel and merge them into the workload in arrival order, ties in file
+// order. Returns false with a message naming the first bad line.
+bool LoadTrace(const std::string& path, int threads, Workload& workload, TraceLoadStats& stats, std::string& error);
+
+// Write the workload's processes as a trace, header included. I/O bursts,
+// groups and deadlines are not part of the format.
+bool SaveTrace(const std::string& path, const Workload& workload, std::string& error);
@@ -0,0 +1,409 @@
+#include "Verify.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "FairShare.h"
+#include "ScanEngine.h"
+#include "Workload.h"
+
+namespace {
+
+int RandomInt(uint64_t& state, int lo, int hi) {
+    return lo + static_cast<int>(SplitMix64(state) % static_cast<uint64_t>(hi - lo + 1));
+}
+
+// Keep arrivals non-decreasing and no later than the work submitted before them
+void NormalizeArrivals(VerifyCase& workload) {
+    int submitted = 0;
+    int previous = 0;
+    for (size_t i = 0; i < workload.burst.size(); i++) {
+        int arrival = std::min(workload.arrival[i], submitted);
+        arrival = std::max(arrival, previous);
+        workload.arrival[i] = arrival;
+        previous = arrival;
+        submitted += workload.burst[i];
+    }
+}
+
+// Wide-time engines also run each case from this clock, past where a 32-bit
+// clock would wrap; their results are shifted back before comparing
+const long long FAR_START = 1LL << 40;
+
+template <typename Time, typename Index>
+void CopyResult(BasicSrtnEngine<Time, Index>& engine, VerifyResult& result, long long start = 0) {
+    result.timeline.clear();
+    for (const auto& segment : engine.Timeline()) {
+        result.timeline.push_back({ static_cast<int>(segment.processIndex),
+            static_cast<int>(segment.startTime - start), static_cast<int>(segment.length) });
+    }
+    const auto& processes = engine.Processes();
+    result.waitingTime.resize(processes.size());
+    result.turnaroundTime.resize(processes.size());
+    for (size_t i = 0; i < processes.size(); i++) {
+        result.waitingTime[i] = static_cast<int>(processes[i].waitingTime);
+        result.turnaroundTime[i] = static_cast<int>(processes[i].turnaroundTime);
+    }
+}
+
+// One per engine width pair that WithEngineFor can pick
+template <typename Time, typename Index, long long START = 0>
+void RunHeapEngine(const VerifyCase& workload, VerifyResult& result) {
+    thread_local BasicSrtnEngine<Time, Index> engine;
+    engine.Reset();
+    BasicProcess<Time> process = { EMPTY_NAME, 0, 0, 0, 0, 0, false };
+    for (size_t i = 0; i < workload.burst.size(); i++) {
+        process.burstTime = workload.burst[i];
+        process.remainingTime = workload.burst[i];
+        engine.Submit(process, static_cast<Time>(START + workload.arrival[i]));
+    }
+    engine.RunToCompletion();
+    CopyResult(engine, result, START);
+}
+
+// Same workload, but later arrivals go through the thread-safe inbox while the
+// engine is stepped to each arrival time, as a live producer would see it
+void RunOnlineEngine(const VerifyCase& workload, VerifyResult& result) {
+    thread_local SrtnEngine engine;
+    engine.Reset();
+    Process process = { EMPTY_NAME, 0, 0, 0, 0, 0, false };
+    for (size_t i = 0; i < workload.burst.size(); i++) {
+        process.burstTime = workload.burst[i];
+        process.remainingTime = workload.burst[i];
+        if (workload.arrival[i] > engine.Now()) {
+            engine.RunUntil(workload.arrival[i]);
+        }
+        engine.Post(process);
+    }
+    engine.RunToCompletion();
+    CopyResult(engine, result);
+}
+
+void RunScanEngine(const VerifyCase& workload, VerifyResult& result) {
+    thread_local ScanEngine engine;
+    engine.Reset();
+    Process process = { EMPTY_NAME, 0, 0, 0, 0, 0, false };
+    for (size_t i = 0; i < workload.burst.size(); i++) {
+        process.burstTime = workload.burst[i];
+        process.remainingTime = workload.burst[i];
+        engine.Submit(process, workload.arrival[i]);
+    }
+    engine.RunToCompletion();
+    result.timeline = engine.Timeline();
+    const auto& processes = engine.Processes();
+    result.waitingTime.resize(processes.size());
+    result.turnaroundTime.resize(processes.size());
+    for (size_t i = 0; i < processes.size(); i++) {
+        result.waitingTime[i] = processes[i].waitingTime;
+        result.turnaroundTime[i] = processes[i].turnaroundTime;
+    }
+}
+
+// One group with no quantum is plain SRTN
+void RunFairShareEngine(const VerifyCase& workload, VerifyResult& result) {
+    thread_local FairShareEngine engine;
+    if (engine.Groups().empty()) {
+        FairShareOptions options;
+        options.quantum = 0;
+        engine.SetOptions(options);
+        engine.AddGroup(1);
+    }
+    engine.Reset();
+    Process process = { EMPTY_NAME, 0, 0, 0, 0, 0, false };
+    for (size_t i = 0; i < workload.burst.size(); i++) {
+        process.burstTime = workload.burst[i];
+        process.remainingTime = workload.burst[i];
+        engine.Submit(process, workload.arrival[i], 0);
+    }
+    engine.RunToCompletion();
+    result.timeline = engine.Timeline();
+    const auto& processes = engine.Processes();
+    result.waitingTime.resize(processes.size());
+    result.turnaroundTime.resize(processes.size());
+    for (size_t i = 0; i < processes.size(); i++) {
+        result.waitingTime[i] = processes[i].waitingTime;
+        result.turnaroundTime[i] = processes[i].turnaroundTime;
+    }
+}
+
+bool Diverges(const VerifyCase& workload, const VerifyEngine& engine, std::string& detail) {
+    VerifyResult expected;
+    VerifyResult actual;
+    RunReferenceCase(workload, expected);
+    engine.run(workload, actual);
+    return !CompareResults(expected, actual, detail);
+}
+
+} // namespace
+
+const std::vector<VerifyEngine>& VerifyEngines() {
+    static const std::vector<VerifyEngine> engines = {
+        { "heap", RunHeapEngine<int, int> },
+        { "heap-32-16", RunHeapEngine<int32_t, uint16_t> },
+        { "heap-32-32", RunHeapEngine<int32_t, uint32_t> },
+        { "heap-64-16", RunHeapEngine<int64_t, uint16_t> },
+        { "heap-64-32", RunHeapEngine<int64_t, uint32_t> },
+        { "heap-64-16-far", RunHeapEngine<int64_t, uint16_t, FAR_START> },
+        { "heap-64-32-far", RunHeapEngine<int64_t, uint32_t, FAR_START> },
+        { "heap-online", RunOnlineEngine },
+        { "scan", RunScanEngine },
+        { "fair-share", RunFairShareEngine },
+    };
+    return engines;
+}
+
+void RunReferenceCase(const VerifyCase& workload, VerifyResult& result) {
+    thread_local std::vector<Process> processes;
+    thread_local std::vector<ExecutionStep> sequence;
+    processes.clear();
+    sequence.clear();
+
+    size_t next = 0;
+    for (;;) {
+        while (next < workload.burst.size() &&
+               workload.arrival[next] <= static_cast<int>(sequence.size())) {
+            processes.push_back({ EMPTY_NAME, workload.burst[next], workload.burst[next], 0, 0, 0, false });
+            next++;
+        }
+        if (!ReferenceTick(processes, sequence)) {
+            break;
+        }
+    }
+
+    CompressSteps(sequence, result.timeline);
+    result.waitingTime.resize(processes.size());
+    result.turnaroundTime.resize(processes.size());
+    for (size_t i = 0; i < processes.size(); i++) {
+        result.waitingTime[i] = processes[i].waitingTime;
+        result.turnaroundTime[i] = processes[i].turnaroundTime;
+    }
+}
+
+void GenerateCase(uint64_t seed, uint64_t caseNumber, const VerifyOptions& options, VerifyCase& workload) {
+    uint64_t state = seed ^ (caseNumber * 0xD1B54A32D192ED03ULL);
+    SplitMix64(state);
+
+    int count = RandomInt(state, 1, options.maxProcesses);
+    // Narrow burst ranges on some cases so ties are common
+    int maxBurst = (SplitMix64(state) & 3) == 0 ? 3 : options.maxBurst;
+
+    workload.burst.resize(count);
+    workload.arrival.resize(count);
+    int submitted = 0;
+    int previous = 0;
+    for (int i = 0; i < count; i++) {
+        workload.burst[i] = RandomInt(state, 1, maxBurst);
+        // About half of the processes are present at the start
+        int arrival = (i == 0 || (SplitMix64(state) & 1)) ? previous : RandomInt(state, previous, submitted);
+        workload.arrival[i] = arrival;
+        previous = arrival;
+        submitted += workload.burst[i];
+    }
+}
+
+bool CompareResults(const VerifyResult& expected, const VerifyResult& actual, std::string& detail) {
+    if (expected.timeline.size() == actual.timeline.size() &&
+        expected.waitingTime == actual.waitingTime &&
+        expected.turnaroundTime == actual.turnaroundTime &&
+        std::equal(expected.timeline.begin(), expected.timeline.end(), actual.timeline.begin(),
+            [](const RunSegment& a, const RunSegment& b) {
+                return a.processIndex == b.processIndex && a.startTime == b.startTime && a.length == b.length;
+            })) {
+        return true;
+    }
+
+    std::vector<ExecutionStep> expectedSteps;
+    std::vector<ExecutionStep> actualSteps;
+    for (const auto& segment : expected.timeline) AppendSteps(segment, expectedSteps);
+    for (const auto& segment : actual.timeline) AppendSteps(segment, actualSteps);
+
+    size_t steps = std::max(expectedSteps.size(), actualSteps.size());
+    for (size_t i = 0; i < steps; i++) {
+        int want = i < expectedSteps.size() ? expectedSteps[i].processIndex : -1;
+        int got = i < actualSteps.size() ? actualSteps[i].processIndex : -1;
+        int wantTime = i < expectedSteps.size() ? expectedSteps[i].timeUnit : -1;
+        int gotTime = i < actualSteps.size() ? actualSteps[i].timeUnit : -1;
+        if (want != got || wantTime != gotTime) {
+            detail = "step " + std::to_string(i) + ": reference ran P" + std::to_string(want) +
+                " at t=" + std::to_string(wantTime) + ", engine ran P" + std::to_string(got) +
+                " at t=" + std::to_string(gotTime);
+            return false;
+        }
+    }
+
+    size_t count = std::max(expected.waitingTime.size(), actual.waitingTime.size());
+    for (size_t i = 0; i < count; i++) {
+        int want = i < expected.waitingTime.size() ? expected.waitingTime[i] : -1;
+        int got = i < actual.waitingTime.size() ? actual.waitingTime[i] : -1;
+        if (want != got) {
+            detail = "P" + std::to_string(i) + " waitingTime: reference " + std::to_string(want) +
+                ", engine " + std::to_string(got);
+            return false;
+        }
+        want = i < expected.turnaroundTime.size() ? expected.turnaroundTime[i] : -1;
+        got = i < actual.turnaroundTime.size() ? actual.turnaroundTime[i] : -1;
+        if (want != got) {
+            detail = "P" + std::to_string(i) + " turnaroundTime: reference " + std::to_string(want) +
+                ", engine " + std::to_string(got);
+            return false;
+        }
+    }
+    detail = "timelines differ";
+    return false;
+}
+
+VerifyCase MinimizeCase(const VerifyCase& workload, const VerifyEngine& engine) {
+    VerifyCase best = workload;
+    std::string detail;
+    bool shrunk = true;
+    while (shrunk) {
+        shrunk = false;
+
+        // Drop whole processes first, they shrink the case fastest
+        for (size_t i = 0; i < best.burst.size() && best.burst.size() > 1; i++) {
+            VerifyCase candidate = best;
+            candidate.burst.erase(candidate.burst.begin() + i);
+            candidate.arrival.erase(candidate.arrival.begin() + i);
+            NormalizeArrivals(candidate);
+            if (Diverges(candidate, engine, detail)) {
+                best = candidate;
+                shrunk = true;
+                i--;
+            }
+        }
+
+        // Shrinking every burst together keeps ties intact
+        for (;;) {
+            VerifyCase candidate = best;
+            bool changed = false;
+            for (auto& burst : candidate.burst) {
+                if (burst > 1) {
+                    burst--;
+                    changed = true;
+                }
+            }
+            NormalizeArrivals(candidate);
+            if (!changed || !Diverges(candidate, engine, detail)) {
+                break;
+            }
+            best = candidate;
+            shrunk = true;
+        }
+
+        for (size_t i = 0; i < best.burst.size(); i++) {
+            while (best.burst[i] > 1) {
+                VerifyCase candidate = best;
+                candidate.burst[i] = candidate.burst[i] > 2 ? candidate.burst[i] / 2 : 1;
+                NormalizeArrivals(candidate);
+                if (!Diverges(candidate, engine, detail)) {
+                    candidate = best;
+                    candidate.burst[i]--;
+                    NormalizeArrivals(candidate);
+                    if (!Diverges(candidate, engine, detail)) {
+                        break;
+                    }
+                }
+                best = candidate;
+                shrunk = true;
+            }
+        }
+
+        for (size_t i = 0; i < best.arrival.size(); i++) {
+            int floor = i == 0 ? 0 : best.arrival[i - 1];
+            while (best.arrival[i] > floor) {
+                VerifyCase candidate = best;
+                candidate.arrival[i]--;
+                if (!Diverges(candidate, engine, detail)) {
+                    break;
+                }
+                best = candidate;
+                shrunk = true;
+            }
+        }
+    }
+    return best;
+}
+
+VerifyReport RunDifferentialCheck(const VerifyOptions& options) {
+    const auto& engines = VerifyEngines();
+    int threads = options.threads > 0 ? options.threads
+        : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    const uint64_t batch = 4096;
+    std::atomic<uint64_t> nextCase(0);
+    std::atomic<uint64_t> casesRun(0);
+    std::atomic<bool> stop(false);
+    std::mutex failureMutex;
+    uint64_t failedCase = UINT64_MAX;
+    size_t failedEngine = 0;
+
+    auto worker = [&]() {
+        VerifyCase workload;
+        VerifyResult expected;
+        VerifyResult actual;
+        std::string detail;
+        while (!stop.load(std::memory_order_relaxed)) {
+            uint64_t first = nextCase.fetch_add(batch, std::memory_order_relaxed);
+            if (first >= options.cases) {
+                break;
+            }
+            uint64_t last = std::min(first + batch, options.cases);
+            for (uint64_t n = first; n < last; n++) {
+                GenerateCase(options.seed, n, options, workload);
+                RunReferenceCase(workload, expected);
+                for (size_t e = 0; e < engines.size(); e++) {
+                    engines[e].run(workload, actual);
+                    if (!CompareResults(expected, actual, detail)) {
+                        std::lock_guard<std::mutex> lock(failureMutex);
+                        if (n < failedCase) {
+                            failedCase = n;
+                            failedEngine = e;
+                        }
+                        stop = true;
+                        break;
+                    }
+                }
+                if (stop.load(std::memory_order_relaxed)) {
+                    casesRun.fetch_add(n - first + 1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            casesRun.fetch_add(last - first, std::memory_order_relaxed);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; i++) {
+        pool.emplace_back(worker);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    VerifyReport report;
+    report.casesRun = casesRun;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (failedCase != UINT64_MAX) {
+        VerifyCase workload;
+        GenerateCase(options.seed, failedCase, options, workload);
+        report.diverged = true;
+        report.caseNumber = failedCase;
+        report.engine = engines[failedEngine].name;
+        report.repro = MinimizeCase(workload, engines[failedEngine]);
+        Diverges(report.repro, engines[failedEngine], report.detail);
+    }
+    return report;
+}
+
+std::string FormatCase(const VerifyCase& workload) {
+    std::string text;
+    for (size_t i = 0; i < workload.burst.size(); i++) {
+        text += "P" + std::to_string(i) + " arrival=" + std::to_string(workload.arrival[i]) +
+            " burst=" + std::to_string(workload.burst[i]) + "\n";
+    }
+    return text;
+}
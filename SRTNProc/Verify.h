@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Scheduler.h"
+
+// A generated workload: process i has burst[i] and is submitted at arrival[i].
+// Arrivals are non-decreasing and never leave the CPU idle, because the
+// reference clock is the number of executed steps and cannot express a gap.
+struct VerifyCase {
+    std::vector<int> burst;
+    std::vector<int> arrival;
+};
+
+struct VerifyResult {
+    std::vector<RunSegment> timeline;
+    std::vector<int> waitingTime;
+    std::vector<int> turnaroundTime;
+};
+
+typedef void (*VerifyEngineFn)(const VerifyCase& workload, VerifyResult& result);
+
+struct VerifyEngine {
+    const char* name;
+    VerifyEngineFn run;
+};
+
+struct VerifyOptions {
+    uint64_t cases = 1000000;
+    uint64_t seed = 1;
+    int threads = 0;            // 0 = one per hardware thread
+    int maxProcesses = 8;
+    int maxBurst = 12;
+};
+
+struct VerifyReport {
+    uint64_t casesRun = 0;
+    double seconds = 0;
+    bool diverged = false;
+    uint64_t caseNumber = 0;    // regenerate with the same seed to reproduce
+    std::string engine;
+    std::string detail;         // first divergence on the minimized case
+    VerifyCase repro;           // minimized failing workload
+};
+
+// Every optimized engine that must match the reference tick loop
+const std::vector<VerifyEngine>& VerifyEngines();
+
+// Drive ReferenceTick over a workload, submitting each process when the
+// step count reaches its arrival, like pressing Add Process mid-run
+void RunReferenceCase(const VerifyCase& workload, VerifyResult& result);
+
+void GenerateCase(uint64_t seed, uint64_t caseNumber, const VerifyOptions& options, VerifyCase& workload);
+
+// Returns false and describes the first difference if the results disagree
+bool CompareResults(const VerifyResult& expected, const VerifyResult& actual, std::string& detail);
+
+// Greedily drop processes and shrink bursts/arrivals while the engine still diverges
+VerifyCase MinimizeCase(const VerifyCase& workload, const VerifyEngine& engine);
+
+VerifyReport RunDifferentialCheck(const VerifyOptions& options);
+
+std::string FormatCase(const VerifyCase& workload);
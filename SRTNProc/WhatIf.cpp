@@ -0,0 +1,207 @@
+#include "WhatIf.h"
+
+#include <algorithm>
+
+template <typename Time, typename Index>
+void BasicWhatIf<Time, Index>::RunBaseline(Time every) {
+    m_marks.clear();
+    m_engine.RecordMarks(&m_marks, every);
+    m_engine.RunToCompletion();
+    m_engine.RecordMarks(nullptr, 0);
+
+    const auto& processes = m_engine.Processes();
+    size_t count = processes.size();
+    m_order = m_engine.Admissions();
+    m_position.assign(count, 0);
+    for (size_t i = 0; i < m_order.size(); i++) {
+        m_position[m_order[i]] = static_cast<Index>(i);
+    }
+    m_arrival = m_engine.Arrivals();
+    m_burst.resize(count);
+    m_finish.resize(count);
+    m_totalTurnaround = 0;
+    m_totalWaiting = 0;
+    for (size_t i = 0; i < count; i++) {
+        m_burst[i] = processes[i].burstTime;
+        m_finish[i] = m_arrival[i] + processes[i].turnaroundTime;
+        m_totalTurnaround += processes[i].turnaroundTime;
+        m_totalWaiting += processes[i].waitingTime;
+    }
+    m_timeline = m_engine.Timeline();
+
+    m_base = WhatIfResult();
+    m_base.makespan = m_engine.Now();
+    m_base.stats = m_engine.Stats();
+    m_base.resimulated = count;
+    if (count > 0) {
+        m_base.meanTurnaround = m_totalTurnaround / count;
+        m_base.meanWaiting = m_totalWaiting / count;
+    }
+    m_from = 0;
+    m_to = m_marks.size();
+    m_changed.clear();
+}
+
+template <typename Time, typename Index>
+WhatIfResult BasicWhatIf<Time, Index>::Query(Index index, Time burst, Time arrival) {
+    if (static_cast<size_t>(index) >= m_burst.size() || m_marks.empty()) {
+        return m_base;
+    }
+    burst = std::max<Time>(1, burst);
+    arrival = std::max<Time>(0, arrival);
+
+    // Before the process first arrives in either run the schedules agree.
+    // Marks are taken before the arrivals at their clock are admitted.
+    Time diverge = std::min(m_arrival[index], arrival);
+    auto later = std::upper_bound(m_marks.begin(), m_marks.end(), diverge,
+        [](Time time, const Mark& mark) { return time < mark.now; });
+    m_from = static_cast<size_t>(later - m_marks.begin()) - 1;
+
+    // Only a mark where the baseline has also admitted the process can match
+    Index position = m_position[index];
+    auto admitted = std::partition_point(m_marks.begin(), m_marks.end(),
+        [position](const Mark& mark) { return mark.admitted <= static_cast<size_t>(position); });
+    size_t first = std::max(m_from + 1, static_cast<size_t>(admitted - m_marks.begin()));
+
+    const Mark& from = m_marks[m_from];
+    m_engine.Rewind(from, m_order, m_burst, m_arrival);
+    m_engine.Revise(index, burst, arrival);
+    m_to = m_engine.RunToMatch(m_marks, first, index);
+
+    // Everything else finishes as in the baseline: processes that completed
+    // before the mark, those still pending at the match, and those running
+    // or ready at the match, which is the baseline's state
+    WhatIfResult result;
+    result.rewoundTo = from.now;
+    double turnaround = m_totalTurnaround;
+    double waiting = m_totalWaiting;
+    // A run to the end counts a miss for every process finishing after its
+    // deadline, so misses follow the recomputed finishes
+    long long misses = m_base.stats.deadlineMisses;
+    const auto& deadlines = m_engine.Deadlines();
+    m_changed.clear();
+    auto recompute = [&](Index i) {
+        const auto& p = m_engine.ProcessAt(i);
+        Time arrived = m_engine.Arrivals()[i];
+        Time finish = p.completed ? arrived + p.turnaroundTime : m_finish[i];
+        Time was = m_finish[i] - m_arrival[i];
+        Time now = finish - arrived;
+        turnaround += static_cast<double>(now) - was;
+        waiting += static_cast<double>(now - p.burstTime) - (was - m_burst[i]);
+        if (!deadlines.empty()) {
+            misses += (finish > deadlines[i] ? 1 : 0) - (m_finish[i] > deadlines[i] ? 1 : 0);
+        }
+        m_changed.push_back({ i, now });
+        if (i == index) {
+            result.turnaround = now;
+        }
+    };
+    for (const auto& entry : from.active) {
+        recompute(entry.index);
+    }
+    for (Index i : m_engine.Admissions()) {
+        recompute(i);
+    }
+    result.resimulated = m_changed.size();
+
+    size_t count = m_burst.size();
+    result.meanTurnaround = turnaround / count;
+    result.meanWaiting = waiting / count;
+    result.stats = m_engine.Stats();
+    result.stats.deadlineMisses = misses;
+    if (m_to < m_marks.size()) {
+        const Mark& to = m_marks[m_to];
+        result.rejoinedAt = to.now;
+        result.makespan = m_base.makespan;
+        result.stats.switches += m_base.stats.switches - to.stats.switches;
+        result.stats.preemptions += m_base.stats.preemptions - to.stats.preemptions;
+        result.stats.switchTime += m_base.stats.switchTime - to.stats.switchTime;
+        result.stats.busyTime += m_base.stats.busyTime - to.stats.busyTime;
+        result.stats.forced += m_base.stats.forced - to.stats.forced;
+        result.stats.slackOverrides += m_base.stats.slackOverrides - to.stats.slackOverrides;
+    }
+    else {
+        result.makespan = m_engine.Now();
+    }
+    return result;
+}
+
+template <typename Time, typename Index>
+void BasicWhatIf<Time, Index>::QueryTimeline(std::vector<Segment>& out) const {
+    auto append = [&out](const Segment& segment) {
+        if (!out.empty() && out.back().processIndex == segment.processIndex &&
+            out.back().startTime + out.back().length == segment.startTime) {
+            out.back().length += segment.length;
+        }
+        else {
+            out.push_back(segment);
+        }
+    };
+
+    // The re-simulated window starts with the last baseline segment at the mark
+    size_t prefix = m_marks.empty() ? 0 : m_marks[m_from].timelineSize;
+    if (prefix > 0) {
+        prefix--;
+    }
+    out.assign(m_timeline.begin(), m_timeline.begin() + prefix);
+    for (const auto& segment : m_engine.Timeline()) {
+        append(segment);
+    }
+    if (m_to >= m_marks.size()) {
+        return;
+    }
+
+    // The rest of the baseline, from where the segment current at the match
+    // had got to
+    const Mark& to = m_marks[m_to];
+    size_t next = to.timelineSize;
+    if (next > 0) {
+        Segment rest = m_timeline[next - 1];
+        Time done = to.last.length;
+        if (rest.length > done) {
+            rest.startTime += done;
+            rest.length -= done;
+            append(rest);
+        }
+    }
+    for (size_t i = next; i < m_timeline.size(); i++) {
+        append(m_timeline[i]);
+    }
+}
+
+template <typename Time, typename Index>
+void BasicWhatIf<Time, Index>::QueryTurnarounds(std::vector<Time>& out) const {
+    out.resize(m_finish.size());
+    for (size_t i = 0; i < m_finish.size(); i++) {
+        out[i] = m_finish[i] - m_arrival[i];
+    }
+    for (const auto& changed : m_changed) {
+        out[changed.index] = changed.time;
+    }
+}
+
+template <typename Time, typename Index>
+size_t BasicWhatIf<Time, Index>::MarkMemory() const {
+    size_t bytes = m_marks.capacity() * sizeof(Mark);
+    for (const auto& mark : m_marks) {
+        bytes += mark.active.capacity() * sizeof(mark.active[0]) +
+            mark.ready.capacity() * sizeof(mark.ready[0]) + mark.waiting.capacity() * sizeof(mark.waiting[0]) +
+            mark.urgent.capacity() * sizeof(mark.urgent[0]);
+    }
+    return bytes;
+}
+
+template <typename Time, typename Index>
+size_t BasicWhatIf<Time, Index>::MemoryUsage() const {
+    return MarkMemory() +
+        (m_order.capacity() + m_position.capacity()) * sizeof(Index) +
+        (m_arrival.capacity() + m_burst.capacity() + m_finish.capacity()) * sizeof(Time) +
+        m_timeline.capacity() * sizeof(Segment) +
+        m_changed.capacity() * sizeof(Turnaround);
+}
+
+template class BasicWhatIf<int, int>;
+template class BasicWhatIf<int32_t, uint16_t>;
+template class BasicWhatIf<int32_t, uint32_t>;
+template class BasicWhatIf<int64_t, uint16_t>;
+template class BasicWhatIf<int64_t, uint32_t>;
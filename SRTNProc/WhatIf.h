@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Scheduler.h"
+
+// One run as a what-if query reports it; also used for the baseline
+struct WhatIfResult {
+    long long rewoundTo = 0;        // Clock of the mark the re-simulation started from
+    long long rejoinedAt = -1;      // Clock where it rejoined the baseline; -1 if it ran to the end
+    size_t resimulated = 0;         // Processes whose schedule was computed again
+    long long makespan = 0;
+    double meanTurnaround = 0;
+    double meanWaiting = 0;
+    long long turnaround = 0;       // Turnaround of the changed process
+    SchedulerStats stats;
+};
+
+// Incremental what-if re-simulation. The baseline run records marks at event
+// boundaries (see BasicSrtnEngine::Mark). A query changes one process's
+// burst or arrival. Nothing before the earlier of its old and new arrival
+// can differ, so the query rewinds to the last mark before that point. It
+// re-simulates only until a later mark finds the run in exactly the
+// baseline's state, and reuses the baseline's schedule from there. Below
+// full load the run rejoins once the affected busy period drains, so a
+// query costs about that busy period instead of the whole trace. In an
+// overloaded run the ready set never drains and a query runs to the end.
+//
+// Queries rank by true bursts: a predictor's averages are not part of a
+// mark. Neither is admission control, so the engine must run with
+// AdmissionPolicy::Unbounded. After RunBaseline the engine belongs to the
+// runner and is left mid-run by queries.
+template <typename Time, typename Index>
+class BasicWhatIf {
+public:
+    typedef BasicSrtnEngine<Time, Index> Engine;
+    typedef typename Engine::Segment Segment;
+
+    explicit BasicWhatIf(Engine& engine) : m_engine(engine) {}
+
+    // Run the engine's submitted, unstarted processes to completion,
+    // marking the first event boundary at or after every multiple of `every`
+    void RunBaseline(Time every);
+    const WhatIfResult& Baseline() const { return m_base; }
+
+    // The baseline with one process's burst and arrival changed
+    WhatIfResult Query(Index index, Time burst, Time arrival);
+
+    // The last query's full timeline and turnarounds, stitched together from
+    // the baseline and the re-simulated window
+    void QueryTimeline(std::vector<Segment>& out) const;
+    void QueryTurnarounds(std::vector<Time>& out) const;
+
+    size_t MarkCount() const { return m_marks.size(); }
+    // Bytes held by the marks alone
+    size_t MarkMemory() const;
+    // Bytes held by the marks and the baseline copies a query reads
+    size_t MemoryUsage() const;
+
+private:
+    typedef typename Engine::Mark Mark;
+
+    struct Turnaround {
+        Index index;
+        Time time;
+    };
+
+    Engine& m_engine;
+    std::vector<Mark> m_marks;
+    std::vector<Index> m_order;         // Baseline admission order
+    std::vector<Index> m_position;      // Each process's place in m_order
+    std::vector<Time> m_arrival;
+    std::vector<Time> m_burst;
+    std::vector<Time> m_finish;         // Baseline completion clock
+    std::vector<Segment> m_timeline;    // Baseline timeline
+    WhatIfResult m_base;
+    double m_totalTurnaround = 0;
+    double m_totalWaiting = 0;
+
+    // Last query, for QueryTimeline and QueryTurnarounds
+    size_t m_from = 0;
+    size_t m_to = 0;
+    std::vector<Turnaround> m_changed;  // Turnarounds the query recomputed
+};
@@ -0,0 +1,154 @@
+#include "Workload.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+uint64_t SplitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+namespace {
+
+// Uniform in (0, 1]
+double RandomUnit(uint64_t& state) {
+    return (static_cast<double>(SplitMix64(state) >> 11) + 1.0) / 9007199254740992.0;
+}
+
+// Split a job's CPU time into bursts around I/O waits. Draws come after the
+// job's own, so a trace without devices is unchanged.
+void AddBursts(const WorkloadOptions& options, int64_t burstTime, uint64_t& state, Workload& workload) {
+    workload.firstBurst.push_back(static_cast<uint32_t>(workload.bursts.size()));
+    double mean = std::max(0.0, options.ioBursts);
+    int64_t waits = static_cast<int64_t>(mean);
+    if (RandomUnit(state) <= mean - waits) {
+        waits++;
+    }
+    // Every burst gets at least one unit of CPU
+    waits = std::min(waits, burstTime - 1);
+
+    int64_t left = burstTime;
+    for (int64_t w = 0; w < waits; w++) {
+        int64_t cpu = std::max<int64_t>(1, left / (waits + 1 - w));
+        int device = static_cast<int>(SplitMix64(state) % options.devices);
+        int64_t io = std::max<int64_t>(1, std::llround(-options.meanIo * std::log(RandomUnit(state))));
+        workload.bursts.push_back({ cpu, device, io });
+        left -= cpu;
+    }
+    workload.bursts.push_back({ left, -1, 0 });
+}
+
+} // namespace
+
+void GenerateWorkload(const WorkloadOptions& options, Workload& workload) {
+    uint64_t state = options.seed;
+    int classes = std::max(1, options.classes);
+
+    // Class c has a typical burst between a quarter and twice the mean
+    std::vector<double> classBurst(classes);
+    for (int c = 0; c < classes; c++) {
+        double spread = classes > 1 ? static_cast<double>(c) / (classes - 1) : 0.5;
+        classBurst[c] = options.meanBurst * (0.25 + 1.75 * spread);
+    }
+
+    std::vector<NameId> className(classes);
+    for (int c = 0; c < classes; c++) {
+        className[c] = ProcessNames().Intern(L"job-" + std::to_wstring(c));
+    }
+
+    workload.processes.clear();
+    workload.arrivalTimes.clear();
+    workload.bursts.clear();
+    workload.firstBurst.clear();
+    workload.groups.clear();
+    workload.deadlines.clear();
+    workload.processes.reserve(options.count);
+    workload.arrivalTimes.reserve(options.count);
+
+    double meanGap = options.load > 0 ? options.meanBurst / options.load : 0.0;
+    double clock = 0.0;
+    for (int i = 0; i < options.count; i++) {
+        int jobClass = static_cast<int>(SplitMix64(state) % classes);
+        // Bursts vary +-50% around the class mean
+        double burst = classBurst[jobClass] * (0.5 + RandomUnit(state));
+        int64_t burstTime = std::max<int64_t>(1, std::llround(burst));
+
+        BasicProcess<int64_t> process = { className[jobClass], burstTime, burstTime, 0, 0, 0, false };
+        process.appearingTime = static_cast<int64_t>(clock);
+        workload.processes.push_back(process);
+        workload.arrivalTimes.push_back(static_cast<int64_t>(clock));
+
+        clock += -meanGap * std::log(RandomUnit(state));
+        if (options.deadlineStretch > 0) {
+            int64_t deadline = -1;
+            if (RandomUnit(state) <= options.deadlineShare) {
+                double stretch = 1.0 + 2.0 * options.deadlineStretch * RandomUnit(state);
+                deadline = process.appearingTime + std::max<int64_t>(1, std::llround(burstTime * stretch));
+            }
+            workload.deadlines.push_back(deadline);
+        }
+        if (options.devices > 0) {
+            AddBursts(options, burstTime, state, workload);
+        }
+    }
+    if (options.devices > 0) {
+        workload.firstBurst.push_back(static_cast<uint32_t>(workload.bursts.size()));
+    }
+}
+
+void AppendTenant(const WorkloadOptions& options, int group, Workload& workload) {
+    WorkloadOptions tenantOptions = options;
+    tenantOptions.devices = 0;
+    Workload tenant;
+    GenerateWorkload(tenantOptions, tenant);
+
+    workload.groups.resize(workload.processes.size(), 0);
+    if (!workload.deadlines.empty() || !tenant.deadlines.empty()) {
+        workload.deadlines.resize(workload.processes.size(), -1);
+        tenant.deadlines.resize(tenant.processes.size(), -1);
+        workload.deadlines.insert(workload.deadlines.end(), tenant.deadlines.begin(), tenant.deadlines.end());
+    }
+    workload.processes.insert(workload.processes.end(), tenant.processes.begin(), tenant.processes.end());
+    workload.arrivalTimes.insert(workload.arrivalTimes.end(), tenant.arrivalTimes.begin(), tenant.arrivalTimes.end());
+    workload.groups.resize(workload.processes.size(), group);
+    // In a trace with I/O the tenant's jobs are single CPU bursts
+    for (const auto& process : tenant.processes) {
+        if (workload.firstBurst.empty()) {
+            break;
+        }
+        workload.bursts.push_back({ process.burstTime, -1, 0 });
+        workload.firstBurst.push_back(static_cast<uint32_t>(workload.bursts.size()));
+    }
+}
+
+EngineWidths WidthsFor(const Workload& workload, const SchedulerOptions& options) {
+    int64_t horizon = 0;
+    for (int64_t arrival : workload.arrivalTimes) {
+        horizon = std::max(horizon, arrival);
+    }
+    for (const auto& process : workload.processes) {
+        horizon += std::max<int64_t>(0, process.burstTime);
+    }
+    for (const auto& burst : workload.bursts) {
+        horizon += std::max<int64_t>(0, burst.io);
+    }
+    // Preemptions on arrival cost one switch back per burst; a maxWait
+    // dispatch preempts once more, then runs its burst out
+    int64_t cpuBursts = std::max<int64_t>(workload.processes.size(), workload.bursts.size());
+    int64_t switches = options.maxWait > 0 ? 3 : 2;
+    horizon += switches * static_cast<int64_t>(std::max(0, options.switchCost)) * cpuBursts;
+    for (int64_t deadline : workload.deadlines) {
+        horizon = std::max(horizon, deadline);
+    }
+
+    bool timed = options.agingPeriod > 0 || options.deadlineMode == DeadlineMode::Slack ||
+        options.deadlineMode == DeadlineMode::LeastLaxity;
+
+    EngineWidths widths;
+    widths.wideTime = horizon >= INT32_MAX || (timed && options.switchCost > 0);
+    widths.wideIndex = workload.processes.size() >= UINT16_MAX;
+    return widths;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Scheduler.h"
+
+// A batch of processes with the time each one is submitted to the engine.
+// Held at 64-bit time; the engine that runs it may be narrower. When the
+// processes do I/O, process i's bursts are bursts[firstBurst[i]] up to
+// bursts[firstBurst[i + 1]]; without I/O firstBurst is empty. groups holds
+// each process's tenant when the trace has several. deadlines holds absolute
+// deadlines, -1 for none, and is empty when no process has one.
+struct Workload {
+    std::vector<BasicProcess<int64_t>> processes;
+    std::vector<int64_t> arrivalTimes;
+    std::vector<BasicBurst<int64_t>> bursts;
+    std::vector<uint32_t> firstBurst;
+    std::vector<int> groups;
+    std::vector<int64_t> deadlines;
+};
+
+struct WorkloadOptions {
+    int count = 10000;
+    uint64_t seed = 1;
+    int meanBurst = 20;
+    double load = 0.9;      // Offered CPU load; above 1.0 the ready set grows without bound
+    int classes = 8;        // Distinct job names, each with its own typical burst
+    int devices = 0;        // I/O devices; with none every job is one CPU burst
+    double ioBursts = 2;    // Mean I/O waits per job, splitting its CPU time between them
+    int meanIo = 10;        // Mean length of one I/O wait
+    double deadlineStretch = 0; // Deadline after arrival: burst times 1 to 1 + 2 * stretch; 0 = none
+    double deadlineShare = 1;   // Fraction of jobs with a deadline
+};
+
+uint64_t SplitMix64(uint64_t& state);
+
+// Synthetic trace with exponential inter-arrival gaps and per-class bursts,
+// named "job-<class>" so repeated job kinds can be recognised. With devices,
+// each job's CPU time is split around I/O waits of exponential length on
+// devices picked at random; the offered CPU load is unchanged. With a
+// deadline stretch, a share of the jobs get deadlines proportional to their
+// CPU time.
+void GenerateWorkload(const WorkloadOptions& options, Workload& workload);
+
+// Append another tenant's trace, generated from its own options without I/O,
+// and tag its processes with group. Processes already in the workload that
+// have no group are tenant 0. Arrivals interleave but indices do not.
+void AppendTenant(const WorkloadOptions& options, int group, Workload& workload);
+
+// Engine widths large enough for a workload. Time goes wide when the clock
+// could pass INT32_MAX: the last arrival plus every CPU and I/O burst plus
+// two switches per CPU burst (one in, one back after a preemption), three
+// with maxWait, or the latest deadline. Aging and the slack and least-laxity
+// modes make decisions as the clock passes rather than at events, so with a
+// switch cost their switches have no such bound and time always goes wide.
+// Indices go wide from 65535 processes, since the all-ones index is
+// NO_PROCESS.
+EngineWidths WidthsFor(const Workload& workload, const SchedulerOptions& options);
+
+// Submit every process at its arrival time, in index order. A workload with
+// I/O needs the engine's devices set first.
+template <typename Time, typename Index>
+void SubmitWorkload(const Workload& workload, BasicSrtnEngine<Time, Index>& engine) {
+    std::vector<BasicBurst<Time>> bursts;
+    for (size_t i = 0; i < workload.processes.size(); i++) {
+        BasicProcess<Time> process = ProcessCast<Time>(workload.processes[i]);
+        Time arrival = static_cast<Time>(workload.arrivalTimes[i]);
+        Index index = 0;
+        if (workload.firstBurst.empty()) {
+            index = engine.Submit(process, arrival);
+        }
+        else {
+            bursts.clear();
+            for (uint32_t b = workload.firstBurst[i]; b < workload.firstBurst[i + 1]; b++) {
+                const auto& burst = workload.bursts[b];
+                bursts.push_back({ static_cast<Time>(burst.cpu), burst.device, static_cast<Time>(burst.io) });
+            }
+            index = engine.Submit(process, arrival, bursts.data(), bursts.size());
+        }
+        if (!workload.deadlines.empty() && workload.deadlines[i] >= 0) {
+            engine.SetDeadline(index, static_cast<Time>(workload.deadlines[i]));
+        }
+    }
+}
+
+// Call fn(engine) with a fresh engine of the narrowest widths that hold the
+// workload, so small runs stay cache-compact and long traces cannot overflow
+template <typename Fn>
+void WithEngineFor(const Workload& workload, const SchedulerOptions& options, Fn fn) {
+    WithEngineWidths(WidthsFor(workload, options), fn);
+}